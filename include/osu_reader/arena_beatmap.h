@@ -0,0 +1,73 @@
+#pragma once
+
+#include "osu_reader/beatmap.h"
+#include "osu_reader/hitobject.h"
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace osu {
+    namespace pmr {
+        /// osu::Slider with all of its buffers taken from a memory resource
+        struct Slider {
+            using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+            using Slider_type = osu::Slider::Slider_type;
+
+            struct Segment {
+                using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+                explicit Segment(allocator_type allocator = {}) : points{allocator} {}
+                Segment(const osu::Slider::Segment& segment, allocator_type allocator);
+                Segment(const Segment& other, allocator_type allocator) : points{other.points, allocator}, type{other.type} {}
+                Segment(Segment&& other, allocator_type allocator) : points{std::move(other.points), allocator}, type{other.type} {}
+                Segment(const Segment&) = default;
+                Segment(Segment&&) noexcept = default;
+                Segment& operator=(const Segment&) = default;
+                Segment& operator=(Segment&&) = default;
+
+                std::pmr::vector<Vector2> points;
+                Slider_type type = {};
+            };
+
+            explicit Slider(allocator_type allocator = {}) : segments{allocator}, points{allocator}, distances{allocator} {}
+            Slider(const osu::Slider& slider, allocator_type allocator);
+            Slider(const Slider& other, allocator_type allocator);
+            Slider(Slider&& other, allocator_type allocator);
+            Slider(const Slider&) = default;
+            Slider(Slider&&) noexcept = default;
+            Slider& operator=(const Slider&) = default;
+            Slider& operator=(Slider&&) = default;
+
+            std::chrono::milliseconds time = {};
+            std::chrono::milliseconds duration = {};
+            Slider_type type = {};
+            std::pmr::vector<Segment> segments;
+            std::pmr::vector<Vector2> points;
+            std::pmr::vector<float> distances;
+            int repeat = 0;
+            float length = 0.f;
+        };
+    }// namespace pmr
+
+    /// Beatmap whose hitobjects live in a single arena owned by it.
+    /// All objects of a map take a handful of large allocations, which are released at once on destruction.
+    class Arena_beatmap {
+        // Declared first, so it outlives the containers using it
+        std::unique_ptr<std::pmr::monotonic_buffer_resource> resource_;
+
+    public:
+        /// initial_size is the size of the first arena block, it grows as needed
+        explicit Arena_beatmap(std::size_t initial_size = 64 * 1024);
+        Arena_beatmap(Arena_beatmap&&) noexcept = default;
+        // Containers can't move between arenas without copying, so there's no assignment
+        Arena_beatmap& operator=(Arena_beatmap&&) = delete;
+
+        /// Everything but the hitobjects, which are left empty
+        Beatmap header = {};
+
+        std::pmr::vector<Hitcircle> circles;
+        std::pmr::vector<pmr::Slider> sliders;
+        std::pmr::vector<Spinner> spinners;
+    };
+}// namespace osu
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "osu_reader/beatmap.h"
+#include "osu_reader/slider_path_cache.h"
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+
+namespace osu {
+    struct Batch_options {
+        /// Number of worker threads, 0 uses one per hardware thread
+        std::size_t threads = 0;
+        /// Determines if subdirectories are searched as well
+        bool recursive = true;
+        /// Determines if slider paths are computed
+        bool slider_paths = false;
+        /// Optional cache of computed slider paths shared by all workers
+        std::shared_ptr<Slider_path_cache> path_cache;
+    };
+
+    /// Receives every beatmap file with its parse result, which is empty if parsing failed.
+    /// Calls are made from the worker threads as soon as a file is done, but never concurrently.
+    /// If a call throws, no further calls are made and parse_directory rethrows the exception once the workers are done.
+    using Batch_callback = std::function<void(const std::filesystem::path& file_path, std::optional<Beatmap> beatmap)>;
+
+    /// Parses all .osu files in directory on a thread pool with one Beatmap_parser per worker.
+    /// Returns the number of files handed to callback, or an empty optional if the directory couldn't be read.
+    std::optional<std::size_t> parse_directory(const std::filesystem::path& directory, const Batch_options& options,
+                                               const Batch_callback& callback);
+}// namespace osu
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "osu_reader/beatmap.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace osu {
+    /// Beat divisors the osu! editor can snap to, from coarse to fine
+    inline constexpr std::array<int, 11> beat_divisors{1, 2, 3, 4, 5, 6, 7, 8, 9, 12, 16};
+
+    struct Beat_snap_options {
+        /// Largest distance to a tick in milliseconds that still counts as snapped.
+        /// Object times are whole milliseconds, so ticks between two of them are always off by some fraction.
+        float tolerance = 1;
+        /// Finest divisor that is tried, only the ones in beat_divisors up to it are used
+        int max_divisor = 16;
+    };
+
+    /// Snap of one object time relative to the uninherited timing point active at it
+    struct Beat_snap {
+        enum class Kind : std::uint8_t {
+            circle,
+            slider_head,
+            slider_tail,
+            spinner_start,
+            spinner_end
+        };
+
+        std::chrono::microseconds time;
+        /// Index of the object in Beatmap::circles, sliders or spinners, depending on kind
+        std::uint32_t object;
+        Kind kind;
+        /// Coarsest divisor with a tick within tolerance, 0 if the time is unsnapped
+        std::uint8_t divisor;
+        /// Milliseconds from the nearest tick of divisor to the time, of the finest divisor tried if unsnapped
+        float error;
+    };
+
+    /// Snaps of every circle, slider head and tail and spinner start and end of beatmap, sorted by time.
+    /// Slider tails are timed from the slider velocity at the head, without rounding to milliseconds.
+    /// Without uninherited timing points nothing is snapped.
+    [[nodiscard]] std::vector<Beat_snap> beat_snaps(const Beatmap& beatmap, const Beat_snap_options& options = {});
+    /// Like the overload above, but replaces the contents of snaps and reuses its memory
+    void beat_snaps(const Beatmap& beatmap, std::vector<Beat_snap>& snaps, const Beat_snap_options& options = {});
+}// namespace osu
@@ -1,13 +1,24 @@
 #pragma once
+#include "osu_reader/arena_beatmap.h"
 #include "osu_reader/beatmap.h"
+#include "osu_reader/beatmap_section.h"
+#include "osu_reader/path_quality.h"
+#include "osu_reader/slider_path_cache.h"
+#include "osu_reader/timing_index.h"
+#include <cstddef>
 #include <functional>// TODO: Reconsider include necessity
 #include <memory>
+#include <type_traits>
 
 namespace osu {
+    class Thread_pool;
+
     class Beatmap_parser {
         class Line_provider {
         public:
             virtual std::optional<std::string_view> get_line() = 0;
+            /// Skips ahead to the next line that starts a section and returns it
+            virtual std::optional<std::string_view> skip_to_section();
             virtual ~Line_provider() = default;
         };
 
@@ -20,23 +31,67 @@ namespace osu {
         std::optional<Beatmap> from_string(const std::string_view beatmap_content);
         std::optional<Beatmap> from_file(const std::filesystem::path& file_path);
 
+        /// Like from_string and from_file, but hitobjects are stored in an arena that belongs to the result
+        std::optional<Arena_beatmap> arena_from_string(std::string_view beatmap_content);
+        std::optional<Arena_beatmap> arena_from_file(const std::filesystem::path& file_path);
+
+        /// Parses without storing hitobjects in a beatmap. Instead, visitor is called with each
+        /// const Hitcircle&, Slider&, Spinner& and Beatmap::Timingpoint& in file order as soon as it is parsed.
+        /// Overloads may be left out, objects of that type are then skipped without being parsed.
+        /// If the visitor returns false, parsing stops right away.
+        /// Slider durations are looked up as sliders are streamed, so they are only correct if [Difficulty] and [TimingPoints]
+        /// come before [HitObjects]. Otherwise they are 0 or use the default slider multiplier.
+        /// Returns false if the beatmap couldn't be read, in the same cases from_string and from_file fail.
+        template<typename Visitor>
+        bool stream_string(std::string_view beatmap_content, Visitor&& visitor);
+        template<typename Visitor>
+        bool stream_file(const std::filesystem::path& file_path, Visitor&& visitor);
+
         /// Determines if slider paths are computed
         bool slider_paths = false;
+        /// Number of threads slider paths are computed on, 0 uses one per hardware thread.
+        /// With anything but 1, paths are computed in parallel once all hitobjects are parsed.
+        /// Streamed sliders always get their path right away, and their duration from the sections before [HitObjects], see stream_string.
+        /// The threads are started by the first beatmap with enough sliders and kept for later ones.
+        std::size_t path_threads = 1;
+        /// Tolerances of the computed slider paths
+        Path_quality path_quality = {};
+        /// Optional cache of computed slider paths, which may be shared with other parsers
+        std::shared_ptr<Slider_path_cache> path_cache;
+        /// Largest distance any computed slider path of the last beatmap may be off the exact curve by,
+        /// as returned by sliderpath. 0 if slider paths aren't computed.
+        [[nodiscard]] float path_deviation() const { return path_deviation_; }
+        /// Sections that are parsed, others are skipped without being read and left in their default state.
+        /// Parsing stops after the last requested section.
+        /// [HitObjects] also requires [Difficulty] and [TimingPoints] for slider durations, so they're always included with it.
+        Beatmap_section sections = Beatmap_section::all;
 
     private:
-        enum class Section {
-            general,
-            editor,
-            metadata,
-            difficulty,
-            events,
-            timingpoints,
-            colours,
-            hitobjects,
-            none
+        using Section = Beatmap_section;
+
+        class String_line_provider;
+        friend class Lazy_beatmap;
+
+        /// Type erased visitor of the streaming interface, callbacks are null for types that aren't visited
+        struct Sink {
+            void* visitor;
+            bool (*circle)(void*, const Hitcircle&);
+            bool (*slider)(void*, const Slider&);
+            bool (*spinner)(void*, const Spinner&);
+            bool (*timingpoint)(void*, const Beatmap::Timingpoint&);
         };
+        template<typename Visitor>
+        static Sink make_sink(Visitor& visitor);
+
+        /// Parse results hold everything but the objects that were passed to sink
+        std::optional<Beatmap> stream_impl(const Sink& sink, std::string_view beatmap_content);
+        std::optional<Beatmap> stream_impl(const Sink& sink, const std::filesystem::path& file_path);
 
         std::optional<Beatmap> parse_impl(Line_provider& line_provider);
+        /// Resets the parser and reads the format version, leaving line_provider right after the version line
+        bool parse_version(Line_provider& line_provider);
+        /// Strips utf16 zero bytes if necessary and trims the line
+        void format_line(std::string_view& line);
 
         void parse_general(std::string_view line);
         void parse_editor(std::string_view line);
@@ -51,8 +106,62 @@ namespace osu {
 
         Beatmap beatmap_ = {};
         Section section_ = Section::none;
+        const Sink* sink_ = nullptr;
+        bool stopped_ = false;
+        Slider streamed_slider_ = {};
+        bool utf16_ = false;
+        std::string utf16_line_;
 
-        using Iterator_t = decltype(beatmap_.timingpoints.cbegin());
-        Iterator_t current_timingpoint_;
+        /// Beat duration of the last uninherited timing point, which inherited points are relative to
+        std::optional<std::chrono::microseconds> parent_beat_duration_;
+        /// Built from the timing points when the first streamed slider needs its duration
+        Timing_index timing_index_;
+        std::optional<Timing_index::Cursor> timing_cursor_;
+        /// Workers for path_threads, shared by copies of the parser
+        std::shared_ptr<Thread_pool> path_pool_;
+        float path_deviation_ = 0;
     };
+
+    namespace detail {
+        template<typename Object, typename Visitor>
+        bool visit_streamed(void* visitor, const Object& object)
+        {
+            auto& v = *static_cast<Visitor*>(visitor);
+            if constexpr(std::is_void_v<std::invoke_result_t<Visitor&, const Object&>>) {
+                v(object);
+                return true;
+            } else
+                return static_cast<bool>(v(object));
+        }
+
+        template<typename Object, typename Visitor>
+        constexpr auto stream_callback() -> bool (*)(void*, const Object&)
+        {
+            if constexpr(std::is_invocable_v<Visitor&, const Object&>) return &visit_streamed<Object, Visitor>;
+            else
+                return nullptr;
+        }
+    }// namespace detail
+
+    template<typename Visitor>
+    Beatmap_parser::Sink Beatmap_parser::make_sink(Visitor& visitor)
+    {
+        return Sink{const_cast<void*>(static_cast<const void*>(std::addressof(visitor))),
+                    detail::stream_callback<Hitcircle, Visitor>(),
+                    detail::stream_callback<Slider, Visitor>(),
+                    detail::stream_callback<Spinner, Visitor>(),
+                    detail::stream_callback<Beatmap::Timingpoint, Visitor>()};
+    }
+
+    template<typename Visitor>
+    bool Beatmap_parser::stream_string(const std::string_view beatmap_content, Visitor&& visitor)
+    {
+        return stream_impl(make_sink(visitor), beatmap_content).has_value();
+    }
+
+    template<typename Visitor>
+    bool Beatmap_parser::stream_file(const std::filesystem::path& file_path, Visitor&& visitor)
+    {
+        return stream_impl(make_sink(visitor), file_path).has_value();
+    }
 }// namespace osu
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+
+namespace osu {
+    /// Sections of a beatmap file, combinable as flags
+    enum class Beatmap_section : std::uint16_t {
+        none = 0,
+        general = 1 << 0,
+        editor = 1 << 1,
+        metadata = 1 << 2,
+        difficulty = 1 << 3,
+        events = 1 << 4,
+        timingpoints = 1 << 5,
+        colours = 1 << 6,
+        hitobjects = 1 << 7,
+        all = (1 << 8) - 1,
+    };
+
+    static inline constexpr Beatmap_section operator|(Beatmap_section a, Beatmap_section b) { return static_cast<Beatmap_section>(static_cast<int>(a) | static_cast<int>(b)); }
+    static inline constexpr Beatmap_section operator&(Beatmap_section a, Beatmap_section b) { return static_cast<Beatmap_section>(static_cast<int>(a) & static_cast<int>(b)); }
+    static inline constexpr Beatmap_section operator~(Beatmap_section a) { return static_cast<Beatmap_section>(~static_cast<int>(a) & static_cast<int>(Beatmap_section::all)); }
+
+    static inline constexpr bool has_sections(const Beatmap_section used, const Beatmap_section test)
+    {
+        return (used & test) == test;
+    }
+}// namespace osu
@@ -34,6 +34,7 @@ namespace osu {
         };
 
         std::chrono::milliseconds time;
+        /// Time of a single slide, the whole slider takes repeat times as long
         std::chrono::milliseconds duration;
         Slider_type type;
         std::vector<Segment> segments;
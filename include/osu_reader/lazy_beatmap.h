@@ -0,0 +1,48 @@
+#pragma once
+
+#include "osu_reader/beatmap.h"
+#include "osu_reader/beatmap_section.h"
+#include "osu_reader/path_quality.h"
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace osu {
+    /// Beatmap whose sections are only parsed when they are first requested.
+    /// Opening it only records where each [Section] starts and ends, which is a single fast scan over the file.
+    class Lazy_beatmap {
+    public:
+        /// The file is memory mapped if possible and kept open for the lifetime of the object
+        static std::optional<Lazy_beatmap> from_file(const std::filesystem::path& file_path);
+        static std::optional<Lazy_beatmap> from_string(std::string beatmap_content);
+
+        Lazy_beatmap(Lazy_beatmap&&) noexcept;
+        Lazy_beatmap& operator=(Lazy_beatmap&&) noexcept;
+        ~Lazy_beatmap();
+
+        /// Parses the requested sections that haven't been parsed yet and returns the beatmap.
+        /// Sections that weren't requested so far are left in their default state.
+        /// [HitObjects] also pulls in [Difficulty] and [TimingPoints], which slider durations depend on.
+        const Beatmap& get(Beatmap_section sections);
+        /// Sections present in the file
+        [[nodiscard]] Beatmap_section available() const;
+        /// Sections parsed so far
+        [[nodiscard]] Beatmap_section parsed() const;
+        [[nodiscard]] int version() const;
+
+        /// Determines if slider paths are computed. Only affects [HitObjects] if they haven't been parsed yet.
+        bool slider_paths = false;
+        /// Tolerances of the computed slider paths
+        Path_quality path_quality = {};
+
+    private:
+        struct Impl;
+
+        explicit Lazy_beatmap(std::unique_ptr<Impl> impl);
+        static std::optional<Lazy_beatmap> from_impl(std::unique_ptr<Impl> impl);
+
+        std::unique_ptr<Impl> impl_;
+    };
+}// namespace osu
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "osu_reader/hitobject.h"
+#include "osu_reader/path_quality.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace osu {
+    /// Computes slider paths when they are first accessed instead of while parsing.
+    /// Paths are cached, and access is safe from any number of threads at once.
+    /// The sliders are referenced, not copied, so they must outlive this object and must not change.
+    class Lazy_slider_paths {
+    public:
+        struct Path {
+            std::vector<Vector2> points;
+            /// Cumulative length along points, ending at the slider length
+            std::vector<float> distances;
+            /// Largest distance points may be off the exact path by, as returned by sliderpath
+            float deviation = 0;
+        };
+
+        explicit Lazy_slider_paths(const std::vector<Slider>& sliders, const Path_quality& quality = {});
+
+        /// Path of the slider at index, the same as computed by Beatmap_parser::slider_paths
+        const Path& operator[](std::size_t index) const;
+        /// Determines if the path at index was computed already
+        [[nodiscard]] bool computed(std::size_t index) const;
+        [[nodiscard]] std::size_t size() const { return sliders_->size(); }
+
+    private:
+        struct Slot {
+            std::once_flag once;
+            std::atomic<bool> done{false};
+            Path path;
+        };
+
+        const std::vector<Slider>* sliders_;
+        Path_quality quality_;
+        std::unique_ptr<Slot[]> slots_;
+    };
+}// namespace osu
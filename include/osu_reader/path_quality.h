@@ -0,0 +1,27 @@
+#pragma once
+
+namespace osu {
+    /// Tolerances of slider path approximation. Larger ones give fewer points, which are faster to compute and use.
+    /// The defaults follow osu!lazer, except for catmull splines, whose detail adapts to their curvature.
+    struct Path_quality {
+        /// Largest distance between bezier curves and their flattened control points, half the largest length of the
+        /// second differences of control points that count as flat. Values below 0.001 are treated as 0.001.
+        float bezier_tolerance = 0.25f;
+        /// Largest distance between perfect circle arcs and the chords they are approximated by.
+        /// Like in osu!lazer, arcs of only a few points can exceed it. Values below 0.001 are treated as 0.001.
+        float arc_tolerance = 0.1f;
+        /// Largest distance between catmull splines and the chords they are approximated by.
+        /// Segments get at most 50 points regardless, so 0 gives the fixed detail of osu!lazer.
+        float catmull_tolerance = 0.1f;
+        /// Largest distance Ramer-Douglas-Peucker simplification of the finished path may move it by, 0 disables it.
+        /// Simplifying takes longer than approximating with larger tolerances, but leaves the fewest points.
+        float simplify_tolerance = 0;
+
+        /// Paths exactly as osu!lazer computes them
+        static constexpr Path_quality exact() { return {0.25f, 0.1f, 0, 0}; }
+        /// Within about a pixel of the exact paths, for difficulty estimation and other analysis
+        static constexpr Path_quality preview() { return {0.5f, 0.5f, 0.5f, 0}; }
+        /// Within a few pixels of the exact paths and simplified, for thumbnails
+        static constexpr Path_quality thumbnail() { return {2.f, 2.f, 2.f, 1.f}; }
+    };
+}// namespace osu
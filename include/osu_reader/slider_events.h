@@ -0,0 +1,36 @@
+#pragma once
+
+#include "osu_reader/beatmap.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace osu {
+    /// Judged point of a slider, as generated by osu!'s slider event generator
+    struct Slider_event {
+        enum class Type : std::uint8_t {
+            head,
+            tick,
+            repeat,
+            tail
+        };
+
+        std::chrono::microseconds time;
+        Vector2 pos;
+        /// Index of the slider in Beatmap::sliders
+        std::uint32_t slider;
+        Type type;
+    };
+
+    /// Heads, ticks, repeats and tails of all sliders in beatmap, sorted by time. Events at the same time keep slider order.
+    /// Slider velocity and tick spacing come from the timing point active at each slider's start.
+    /// Sliders without a computed path get one computed on the fly, which doesn't change them.
+    [[nodiscard]] std::vector<Slider_event> slider_events(const Beatmap& beatmap);
+    /// Like the overload above, but replaces the contents of events and reuses its memory
+    void slider_events(const Beatmap& beatmap, std::vector<Slider_event>& events);
+
+    /// Combo of a full combo: every circle, spinner and slider event counts once.
+    /// Slider events are only counted, not generated, so no paths are needed.
+    [[nodiscard]] std::size_t max_combo(const Beatmap& beatmap);
+}// namespace osu
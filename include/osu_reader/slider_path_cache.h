@@ -0,0 +1,58 @@
+#pragma once
+
+#include "osu_reader/hitobject.h"
+#include "osu_reader/path_quality.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace osu {
+    /// Computed slider paths keyed by everything they depend on: segments, length and path quality.
+    /// Identical sliders, which are common across the difficulties of a beatmap set, are only computed once.
+    /// Safe to share between any number of parsers and threads. The least recently used paths are evicted
+    /// once the cached paths take up more than the memory budget.
+    class Slider_path_cache {
+    public:
+        struct Path {
+            std::vector<Vector2> points;
+            /// Cumulative length along points, ending at the slider length
+            std::vector<float> distances;
+            /// Largest distance points may be off the exact path by, as returned by sliderpath
+            float deviation = 0;
+        };
+
+        struct Stats {
+            std::size_t hits;
+            std::size_t misses;
+            std::size_t evictions;
+            std::size_t entries;
+            /// Approximate memory taken by the cached paths and their keys
+            std::size_t bytes;
+
+            [[nodiscard]] double hit_rate() const
+            {
+                const auto lookups = hits + misses;
+                return lookups == 0 ? 0. : static_cast<double>(hits) / static_cast<double>(lookups);
+            }
+        };
+
+        explicit Slider_path_cache(std::size_t memory_budget = std::size_t{64} << 20);
+        Slider_path_cache(const Slider_path_cache&) = delete;
+        Slider_path_cache& operator=(const Slider_path_cache&) = delete;
+        ~Slider_path_cache();
+
+        /// Path of slider, computed and cached if it isn't cached yet.
+        /// The path stays valid for as long as it is held, even if it is evicted in the meantime.
+        std::shared_ptr<const Path> get(const Slider& slider, const Path_quality& quality = {});
+        /// Sets points and distances of slider from the cache and returns the deviation, like compute_slider_path does
+        float compute(Slider& slider, const Path_quality& quality = {});
+
+        [[nodiscard]] Stats stats() const;
+        /// Removes all paths and resets the statistics
+        void clear();
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> impl_;
+    };
+}// namespace osu
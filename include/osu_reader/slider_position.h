@@ -0,0 +1,67 @@
+#pragma once
+
+#include <osu_reader/hitobject.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Ball position queries along slider paths. The sliders need their points and distances, either from
+// Beatmap_parser::slider_paths or compute_slider_path. A slider without points stays at its first control point.
+namespace osu {
+    /// Position at distance along points, whose cumulative distances are from pathlengths. Clamped to both ends.
+    [[nodiscard]] Vector2 position_at_distance(const std::vector<Vector2>& points, const std::vector<float>& distances, float distance);
+
+    /// Ball position at progress through the whole slider, from 0 at the start to 1 at the end.
+    /// Repeats run back and forth along the path.
+    [[nodiscard]] Vector2 position_at_progress(const Slider& slider, float progress);
+    /// Ball position at time, clamped to the head before the slider starts and to the end after it's done
+    [[nodiscard]] Vector2 position_at_time(const Slider& slider, std::chrono::milliseconds time);
+
+    /// Like position_at_progress for every value of progress, replacing the contents of positions.
+    /// Each search starts where the previous one ended, so inputs close to each other, such as sorted ones, are cheap.
+    void positions_at_progress(const Slider& slider, const std::vector<float>& progress, std::vector<Vector2>& positions);
+    /// Like position_at_time for every value of times, replacing the contents of positions.
+    /// Each search starts where the previous one ended, so inputs close to each other, such as replay frames, are cheap.
+    void positions_at_times(const Slider& slider, const std::vector<std::chrono::milliseconds>& times, std::vector<Vector2>& positions);
+
+    /// Replaces the contents of output with count points spaced evenly by arc length along points,
+    /// from the first to the last point. Results are the same as position_at_distance for each of them.
+    void resample_path(const std::vector<Vector2>& points, const std::vector<float>& distances, std::size_t count,
+                       std::vector<Vector2>& output);
+
+    /// Copy of a path with a uniform arc length index, for sliders that are sampled many times.
+    /// The path length is split into equal buckets that each remember their first segment,
+    /// so a lookup is a multiplication plus a short forward scan instead of a search.
+    /// Lookups give exactly the same positions as the functions above.
+    class Arc_length_table {
+    public:
+        Arc_length_table() = default;
+        /// Builds buckets many buckets, or one per segment if buckets is 0
+        Arc_length_table(std::vector<Vector2> points, std::vector<float> distances, std::size_t buckets = 0);
+        /// Table over the path of slider, which stays at its first control point if it has no path
+        explicit Arc_length_table(const Slider& slider, std::size_t buckets = 0);
+
+        /// Position at distance along the path, clamped to both ends
+        [[nodiscard]] Vector2 at_distance(float distance) const;
+        /// Position at fraction of the path length, from 0 at the first point to 1 at the last
+        [[nodiscard]] Vector2 at_fraction(float fraction) const;
+        /// Like resample_path over the table's path
+        void resample(std::size_t count, std::vector<Vector2>& output) const;
+
+        [[nodiscard]] float length() const { return distances_.empty() ? 0 : distances_.back(); }
+        [[nodiscard]] const std::vector<Vector2>& points() const { return points_; }
+        [[nodiscard]] const std::vector<float>& distances() const { return distances_; }
+
+    private:
+        std::vector<Vector2> points_;
+        std::vector<float> distances_;
+        std::vector<std::uint32_t> buckets_;
+        float buckets_per_distance_ = 0;
+    };
+
+    /// position_at_progress using table, which has to be built from slider
+    [[nodiscard]] Vector2 position_at_progress(const Slider& slider, const Arc_length_table& table, float progress);
+    /// position_at_time using table, which has to be built from slider
+    [[nodiscard]] Vector2 position_at_time(const Slider& slider, const Arc_length_table& table, std::chrono::milliseconds time);
+}// namespace osu
@@ -1,9 +1,29 @@
 #pragma once
 
 #include <osu_reader/hitobject.h>
+#include <osu_reader/path_quality.h>
 
 namespace osu {
+    class Slider_path_cache;
+
     [[nodiscard]] std::vector<osu::Vector2> sliderpath(const osu::Slider& slider);
+    /// Computes the path into path, replacing its contents but reusing its memory
+    void sliderpath(const osu::Slider& slider, std::vector<osu::Vector2>& path);
+    /// Like the overload above with the tolerances of quality.
+    /// Returns the largest distance the path may be off the exact curves by: the error bound of the tolerances
+    /// of its segment types plus the largest distance simplification moved it by. Paths of only linear segments are exact.
+    float sliderpath(const osu::Slider& slider, std::vector<osu::Vector2>& path, const Path_quality& quality);
     [[nodiscard]] std::vector<float> pathlengths(const std::vector<osu::Vector2>& points);
     void fix_slider_length(osu::Slider& slider);
+    /// Computes points and distances of slider, fixed to its length. Paths are taken from cache if there is one.
+    /// Returns the deviation of the path like sliderpath.
+    float compute_slider_path(osu::Slider& slider, const Path_quality& quality = {}, Slider_path_cache* cache = nullptr);
+    /// compute_slider_path for every slider, split into chunks on threads threads, 0 uses one per hardware thread.
+    /// Every slider is computed independently, so the results don't depend on the number of threads.
+    /// The threads are started for every call, Beatmap_parser keeps its own across parses instead.
+    /// Returns the largest deviation of all paths.
+    float compute_slider_paths(std::vector<osu::Slider>& sliders, std::size_t threads = 0, const Path_quality& quality = {},
+                               Slider_path_cache* cache = nullptr);
+    /// Shortens or extends points and their distances from pathlengths so that the path ends at length
+    void fix_path_length(std::vector<osu::Vector2>& points, std::vector<float>& distances, float length);
 }// namespace osu
@@ -1,7 +1,9 @@
 #pragma once
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <locale>
+#include <optional>
 #include <string_view>
 #include <vector>
 
@@ -86,4 +88,72 @@ namespace osu {
     }
 
     std::vector<std::string_view> split(std::string_view s, char delim);
+
+    /// Splits s like split(), but writes at most capacity tokens to tokens without allocating.
+    /// Returns the total number of tokens, so a result above capacity means tokens were dropped.
+    std::size_t split(std::string_view s, char delim, std::string_view* tokens, std::size_t capacity);
+
+    /// Non-owning view of a contiguous sequence of tokens
+    class Token_span {
+    public:
+        constexpr Token_span() = default;
+        constexpr Token_span(const std::string_view* data, const std::size_t size) : data_{data}, size_{size} {}
+        Token_span(const std::vector<std::string_view>& tokens) : data_{tokens.data()}, size_{tokens.size()} {}
+
+        [[nodiscard]] constexpr std::size_t size() const { return size_; }
+        [[nodiscard]] constexpr bool empty() const { return size_ == 0; }
+        [[nodiscard]] constexpr const std::string_view& operator[](const std::size_t i) const { return data_[i]; }
+        [[nodiscard]] constexpr const std::string_view* begin() const { return data_; }
+        [[nodiscard]] constexpr const std::string_view* end() const { return data_ + size_; }
+
+    private:
+        const std::string_view* data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+
+    /// Stack allocated token storage for at most Capacity tokens
+    template<std::size_t Capacity>
+    class Fixed_tokens {
+    public:
+        [[nodiscard]] constexpr std::size_t size() const { return size_; }
+        [[nodiscard]] constexpr bool empty() const { return size_ == 0; }
+        /// Whether the last split produced more than Capacity tokens
+        [[nodiscard]] constexpr bool overflowed() const { return overflowed_; }
+        [[nodiscard]] constexpr std::string_view& operator[](const std::size_t i) { return tokens_[i]; }
+        [[nodiscard]] constexpr const std::string_view& operator[](const std::size_t i) const { return tokens_[i]; }
+        [[nodiscard]] constexpr std::string_view* begin() { return tokens_.data(); }
+        [[nodiscard]] constexpr std::string_view* end() { return tokens_.data() + size_; }
+        [[nodiscard]] constexpr const std::string_view* begin() const { return tokens_.data(); }
+        [[nodiscard]] constexpr const std::string_view* end() const { return tokens_.data() + size_; }
+
+        constexpr operator Token_span() const { return {tokens_.data(), size_}; }
+
+        /// Replaces the stored tokens with those of s. Returns false on overflow, in which case
+        /// the first Capacity tokens are still available.
+        bool split(const std::string_view s, const char delim)
+        {
+            const auto count = osu::split(s, delim, tokens_.data(), Capacity);
+            overflowed_ = count > Capacity;
+            size_ = overflowed_ ? Capacity : count;
+            return !overflowed_;
+        }
+
+    private:
+        std::array<std::string_view, Capacity> tokens_{};
+        std::size_t size_ = 0;
+        bool overflowed_ = false;
+    };
+
+    /// Yields the tokens of s one by one, skipping empty ones like split() does
+    class Tokenizer {
+    public:
+        Tokenizer(const std::string_view s, const char delim) : s_{s}, delim_{delim} {}
+
+        std::optional<std::string_view> next();
+
+    private:
+        std::string_view s_;
+        std::size_t pos_ = 0;
+        char delim_;
+    };
 }// namespace osu
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "osu_reader/beatmap.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace osu {
+    /// Timing points split into two time sorted tracks: uninherited points, which set the BPM and meter,
+    /// and every point, which sets slider velocity, samples and kiai. Built once, then queried by binary search
+    /// or by a cursor for times in increasing order.
+    /// Times before the first point of a track get that point's values, like osu! does.
+    class Timing_index {
+    public:
+        /// Everything the timing points say about one moment of the beatmap
+        struct State {
+            /// Beat duration of the active uninherited point
+            std::chrono::microseconds beat_duration;
+            /// Beat duration with slider velocity applied, Beatmap::Timingpoint::beat_duration of the active point
+            std::chrono::microseconds effective_beat_duration;
+            float slider_velocity;
+            int meter;
+            int sample_set;
+            int sample_index;
+            int sample_volume;
+            bool kiai;
+        };
+
+        /// Uninherited point
+        struct Timing {
+            std::chrono::milliseconds time;
+            std::chrono::microseconds beat_duration;
+            int meter;
+        };
+        /// Any point, uninherited ones have a slider velocity of 1
+        struct Effect {
+            std::chrono::milliseconds time;
+            std::chrono::microseconds effective_beat_duration;
+            float slider_velocity;
+            int sample_set;
+            int sample_index;
+            int sample_volume;
+            bool kiai;
+        };
+
+        /// Walks the index along increasing times, each step costs constant time amortised.
+        /// Going back in time falls back to a binary search.
+        class Cursor {
+        public:
+            explicit Cursor(const Timing_index& index) : index_{&index} {}
+
+            [[nodiscard]] State seek(std::chrono::milliseconds time);
+
+        private:
+            const Timing_index* index_;
+            std::size_t timing_ = 0;
+            std::size_t effect_ = 0;
+        };
+
+        Timing_index() = default;
+        /// Points at the same time keep their order, so the later one in timingpoints wins
+        explicit Timing_index(const std::vector<Beatmap::Timingpoint>& timingpoints);
+
+        /// State at time. Without any timing points, durations are 0 and slider velocity is 1.
+        [[nodiscard]] State at(std::chrono::milliseconds time) const;
+        [[nodiscard]] Cursor cursor() const { return Cursor{*this}; }
+
+        [[nodiscard]] const std::vector<Timing>& timings() const { return timings_; }
+        [[nodiscard]] const std::vector<Effect>& effects() const { return effects_; }
+        [[nodiscard]] bool empty() const { return effects_.empty(); }
+
+    private:
+        [[nodiscard]] State state(std::size_t timing, std::size_t effect) const;
+
+        std::vector<Timing> timings_;
+        std::vector<Effect> effects_;
+    };
+
+    /// Sets the duration of every slider from its length and the timing point active at its start, in one merge
+    /// sweep over the sliders in time order. Sliders keep their durations if there are no timing points.
+    /// Sliders is any random access container of osu::Slider or osu::pmr::Slider.
+    template<typename Sliders>
+    void compute_slider_durations(Sliders& sliders, const Timing_index& index, float slider_multiplier);
+    /// compute_slider_durations over the sliders and timing points of beatmap
+    void compute_slider_durations(Beatmap& beatmap);
+
+    template<typename Sliders>
+    void compute_slider_durations(Sliders& sliders, const Timing_index& index, const float slider_multiplier)
+    {
+        if(index.empty() || sliders.empty()) return;
+
+        // Merge the sliders with the timing points. Sliders are nearly always sorted by time,
+        // otherwise they are visited through a time sorted order so the cursor still only moves forward.
+        thread_local std::vector<std::uint32_t> order;
+        const auto by_time = [](const auto& a, const auto& b) { return a.time < b.time; };
+        const auto sorted = std::is_sorted(sliders.cbegin(), sliders.cend(), by_time);
+        if(!sorted) {
+            order.resize(sliders.size());
+            std::iota(order.begin(), order.end(), std::uint32_t{0});
+            std::stable_sort(order.begin(), order.end(), [&](const std::uint32_t a, const std::uint32_t b) {
+                return sliders[a].time < sliders[b].time;
+            });
+        }
+
+        thread_local std::vector<float> beat_durations;
+        beat_durations.resize(sliders.size());
+        auto cursor = index.cursor();
+        for(std::size_t i = 0; i < sliders.size(); ++i) {
+            const auto slider = sorted ? i : order[i];
+            beat_durations[slider] = static_cast<float>(cursor.seek(sliders[slider].time).effective_beat_duration.count());
+        }
+
+        // Then the same multiply for every slider, without any timing state
+        const auto pixels_per_beat = slider_multiplier * 100.f;
+        for(std::size_t i = 0; i < sliders.size(); ++i) {
+            const auto duration = std::chrono::duration<float, std::micro>{sliders[i].length / pixels_per_beat * beat_durations[i]};
+            sliders[i].duration = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+        }
+    }
+}// namespace osu
@@ -0,0 +1,41 @@
+#include "osu_reader/arena_beatmap.h"
+
+osu::pmr::Slider::Segment::Segment(const osu::Slider::Segment& segment, allocator_type allocator)
+    : points{segment.points.cbegin(), segment.points.cend(), allocator}, type{segment.type}
+{
+}
+
+osu::pmr::Slider::Slider(const osu::Slider& slider, allocator_type allocator)
+    : time{slider.time}, duration{slider.duration}, type{slider.type},
+      segments{allocator},
+      points{slider.points.cbegin(), slider.points.cend(), allocator},
+      distances{slider.distances.cbegin(), slider.distances.cend(), allocator},
+      repeat{slider.repeat}, length{slider.length}
+{
+    segments.reserve(slider.segments.size());
+    for(const auto& segment : slider.segments) segments.emplace_back(segment);
+}
+
+osu::pmr::Slider::Slider(const Slider& other, allocator_type allocator)
+    : time{other.time}, duration{other.duration}, type{other.type},
+      segments{other.segments, allocator},
+      points{other.points, allocator},
+      distances{other.distances, allocator},
+      repeat{other.repeat}, length{other.length}
+{
+}
+
+osu::pmr::Slider::Slider(Slider&& other, allocator_type allocator)
+    : time{other.time}, duration{other.duration}, type{other.type},
+      segments{std::move(other.segments), allocator},
+      points{std::move(other.points), allocator},
+      distances{std::move(other.distances), allocator},
+      repeat{other.repeat}, length{other.length}
+{
+}
+
+osu::Arena_beatmap::Arena_beatmap(const std::size_t initial_size)
+    : resource_{std::make_unique<std::pmr::monotonic_buffer_resource>(initial_size)},
+      circles{resource_.get()}, sliders{resource_.get()}, spinners{resource_.get()}
+{
+}
@@ -0,0 +1,73 @@
+#include "osu_reader/batch_parser.h"
+#include "osu_reader/beatmap_parser.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+std::optional<std::size_t> osu::parse_directory(const std::filesystem::path& directory, const Batch_options& options,
+                                                const Batch_callback& callback)
+{
+    std::error_code ec;
+    if(!std::filesystem::is_directory(directory, ec)) return std::nullopt;
+
+    const auto threads = options.threads != 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+
+    // Parsers are stateful, so every worker gets its own
+    std::vector<std::unique_ptr<Beatmap_parser>> parsers;
+    for(std::size_t i = 0; i < threads; ++i) {
+        parsers.push_back(std::make_unique<Beatmap_parser>());
+        parsers.back()->slider_paths = options.slider_paths;
+        parsers.back()->path_cache = options.path_cache;
+    }
+
+    std::mutex callback_mutex;
+    std::exception_ptr callback_exception;
+    std::size_t file_count = 0;
+
+    // Declared after everything its tasks use, so that it finishes them before any of it is destroyed
+    Thread_pool pool{threads};
+
+    const auto submit_file = [&](const std::filesystem::directory_entry& entry) {
+        std::error_code entry_ec;
+        if(!entry.is_regular_file(entry_ec) || entry.path().extension() != ".osu") return;
+        ++file_count;
+
+        pool.submit([&, file_path = entry.path()] {
+            std::optional<Beatmap> beatmap;
+            try {
+                beatmap = parsers[Thread_pool::current_worker()]->from_file(file_path);
+            } catch(const std::exception&) {
+                // Treated like any other file that couldn't be parsed
+            }
+
+            // Tasks must not throw, so the first exception of callback is passed on after all tasks are done
+            const std::lock_guard lock{callback_mutex};
+            if(callback_exception) return;
+            try {
+                callback(file_path, std::move(beatmap));
+            } catch(...) {
+                callback_exception = std::current_exception();
+            }
+        });
+    };
+
+    // Files are submitted while the directory is still being walked, so parsing starts right away
+    constexpr auto iterator_options = std::filesystem::directory_options::skip_permission_denied;
+    if(options.recursive) {
+        for(auto it = std::filesystem::recursive_directory_iterator{directory, iterator_options, ec};
+            !ec && it != std::filesystem::recursive_directory_iterator{}; it.increment(ec)) {
+            submit_file(*it);
+        }
+    } else {
+        for(auto it = std::filesystem::directory_iterator{directory, iterator_options, ec};
+            !ec && it != std::filesystem::directory_iterator{}; it.increment(ec)) {
+            submit_file(*it);
+        }
+    }
+
+    pool.wait();
+    if(callback_exception) std::rethrow_exception(callback_exception);
+    return file_count;
+}
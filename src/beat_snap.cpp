@@ -0,0 +1,100 @@
+#include "osu_reader/beat_snap.h"
+#include "osu_reader/timing_index.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    using Kind = osu::Beat_snap::Kind;
+
+    double microseconds(const std::chrono::milliseconds time)
+    {
+        return static_cast<double>(time.count()) * 1000;
+    }
+
+    struct Object_time {
+        double time;// In microseconds
+        std::uint32_t object;
+        Kind kind;
+    };
+
+    // Every object time, sorted
+    void collect_times(const osu::Beatmap& beatmap, const osu::Timing_index& index, std::vector<Object_time>& times)
+    {
+        times.clear();
+        times.reserve(beatmap.circles.size() + 2 * (beatmap.sliders.size() + beatmap.spinners.size()));
+        for(std::uint32_t i = 0; i < beatmap.circles.size(); ++i) times.push_back({microseconds(beatmap.circles[i].time), i, Kind::circle});
+
+        // Tails from slider velocity, the parsed durations are rounded down to whole milliseconds
+        auto cursor = index.cursor();
+        const auto pixels_per_beat = static_cast<double>(beatmap.slider_multiplier) * 100;
+        for(std::uint32_t i = 0; i < beatmap.sliders.size(); ++i) {
+            const auto& slider = beatmap.sliders[i];
+            const auto head = microseconds(slider.time);
+            const auto beat_duration = static_cast<double>(cursor.seek(slider.time).effective_beat_duration.count());
+            const auto span = beat_duration > 0 && pixels_per_beat > 0 ? slider.length / pixels_per_beat * beat_duration
+                                                                        : static_cast<double>(std::chrono::microseconds{slider.duration}.count());
+            times.push_back({head, i, Kind::slider_head});
+            times.push_back({head + std::max(slider.repeat, 1) * span, i, Kind::slider_tail});
+        }
+
+        for(std::uint32_t i = 0; i < beatmap.spinners.size(); ++i) {
+            times.push_back({microseconds(beatmap.spinners[i].start), i, Kind::spinner_start});
+            times.push_back({microseconds(beatmap.spinners[i].end), i, Kind::spinner_end});
+        }
+
+        const auto by_time = [](const Object_time& a, const Object_time& b) { return a.time < b.time; };
+        std::stable_sort(times.begin(), times.end(), by_time);
+    }
+}// namespace
+
+std::vector<osu::Beat_snap> osu::beat_snaps(const Beatmap& beatmap, const Beat_snap_options& options)
+{
+    std::vector<Beat_snap> snaps;
+    beat_snaps(beatmap, snaps, options);
+    return snaps;
+}
+
+void osu::beat_snaps(const Beatmap& beatmap, std::vector<Beat_snap>& snaps, const Beat_snap_options& options)
+{
+    const auto index = Timing_index{beatmap.timingpoints};
+    thread_local std::vector<Object_time> times;
+    collect_times(beatmap, index, times);
+
+    snaps.resize(times.size());
+    for(std::size_t i = 0; i < times.size(); ++i) {
+        snaps[i] = {std::chrono::microseconds{std::llround(times[i].time)}, times[i].object, times[i].kind, 0, 0};
+    }
+
+    if(index.timings().empty()) return;
+
+    // Offsets from the active uninherited point in beats, merged along the sorted times
+    thread_local std::vector<double> beats;
+    thread_local std::vector<double> beat_durations;
+    beats.resize(times.size());
+    beat_durations.resize(times.size());
+    const auto& timings = index.timings();
+    std::size_t timing = 0;
+    for(std::size_t i = 0; i < times.size(); ++i) {
+        while(timing + 1 < timings.size() && microseconds(timings[timing + 1].time) <= times[i].time) ++timing;
+        const auto beat_duration = static_cast<double>(timings[timing].beat_duration.count());
+        beat_durations[i] = beat_duration > 0 ? beat_duration : 0;
+        beats[i] = beat_duration > 0 ? (times[i].time - microseconds(timings[timing].time)) / beat_duration : 0;
+    }
+
+    // One pass per divisor from coarse to fine over all objects, each object keeps the first divisor within tolerance.
+    // Unsnapped objects are left with the error of the finest divisor.
+    const auto tolerance = static_cast<double>(options.tolerance) * 1000;
+    for(const auto divisor : beat_divisors) {
+        if(divisor > options.max_divisor) break;
+
+        const auto ticks_per_beat = static_cast<double>(divisor);
+        for(std::size_t i = 0; i < snaps.size(); ++i) {
+            if(snaps[i].divisor != 0 || beat_durations[i] <= 0) continue;
+
+            const auto ticks = beats[i] * ticks_per_beat;
+            const auto error = (ticks - std::floor(ticks + 0.5)) * beat_durations[i] / ticks_per_beat;
+            snaps[i].error = static_cast<float>(error / 1000);
+            if(std::abs(error) <= tolerance) snaps[i].divisor = static_cast<std::uint8_t>(divisor);
+        }
+    }
+}
@@ -1,10 +1,15 @@
 #include "osu_reader/beatmap_parser.h"
+#include "hitobject/parallel_sliderpath.h"
 #include "hitobject/parse_hitobject.h"
+#include "key_matcher.h"
+#include "mapped_file.h"
 #include "parse_string.h"
-#include "timingpoints_helper.h"
+#include "string_line_provider.h"
 #include "util.h"
+#include <algorithm>
 #include <array>
 #include <fstream>
+#include <thread>
 #include <osu_reader/sliderpath.h>
 #include <variant>
 
@@ -24,6 +29,10 @@ std::optional<osu::Beatmap> osu::Beatmap_parser::from_file(const std::filesystem
         std::string line = {};
     };
 
+    // Parse the mapped bytes in place so no line has to be copied
+    if(const auto mapped = Mapped_file{file_path}; mapped.is_mapped()) return from_string(mapped.view());
+
+    // Fall back to stream reading for files that can't be mapped
     std::ifstream file{file_path};
     if(!file.is_open()) return std::nullopt;
 
@@ -34,26 +43,6 @@ std::optional<osu::Beatmap> osu::Beatmap_parser::from_file(const std::filesystem
 
 std::optional<osu::Beatmap> osu::Beatmap_parser::from_string(const std::string_view beatmap_content)
 {
-    class String_line_provider : public Line_provider {
-    public:
-        explicit String_line_provider(std::string_view content) : content{content} {}
-        inline std::optional<std::string_view> get_line() override
-        {
-            if(last_pos == std::string_view::npos || last_pos >= content.size()) return std::nullopt;
-
-            const auto start_pos = last_pos;
-
-            const auto pos = content.find('\n', last_pos);
-            last_pos = (pos == std::string_view::npos) ? content.size() : pos + 1;
-
-            return content.substr(start_pos, last_pos - start_pos);
-        }
-
-    private:
-        std::string_view content;
-        std::size_t last_pos = 0;
-    };
-
     auto provider = String_line_provider(beatmap_content);
 
     return parse_impl(provider);
@@ -69,25 +58,22 @@ using Beatmap_types = std::variant<int osu::Beatmap::*, float osu::Beatmap::*, b
 using Beatmap_match_pair = std::pair<const std::string_view, Beatmap_types>;
 
 template<std::size_t N>
-void if_found_parse(const std::array<Beatmap_match_pair, N>& map,
+void if_found_parse(const osu::Key_matcher<Beatmap_types, N>& matcher,
                     const std::string_view line_element_string, const std::string_view value_string,
                     osu::Beatmap& bm)
 {
-    if(const auto match = std::find_if(map.cbegin(), map.cend(),
-                                       [line_element = osu::ltrim_view(line_element_string)](const auto& e) {
-                                           return e.first == line_element;
-                                       });
-       match != map.cend()) {
+    if(const auto* const match = matcher.find(osu::ltrim_view(line_element_string));
+       match != nullptr) {
         std::visit([&value_string, &bm](const auto& e) {
             osu::parse_value(osu::ltrim_view(value_string), bm.*e);
         },
-                   match->second);
+                   *match);
     }
 }
 
 void osu::Beatmap_parser::parse_general(const std::string_view line)
 {
-    static constexpr std::array<Beatmap_match_pair, 15> matcher{
+    static constexpr Key_matcher matcher{std::array<Beatmap_match_pair, 15>{
             Beatmap_match_pair{"AudioFilename", &Beatmap::audio_file},
             Beatmap_match_pair{"AudioLeadIn", &Beatmap::audio_lead_in},
             Beatmap_match_pair{"PreviewTime", &Beatmap::preview_time},
@@ -103,33 +89,33 @@ void osu::Beatmap_parser::parse_general(const std::string_view line)
             Beatmap_match_pair{"WidescreenStoryboard", &Beatmap::widescreen_storyboard},
             Beatmap_match_pair{"SpecialStyle", &Beatmap::special_style},
             Beatmap_match_pair{"UseSkinSprites", &Beatmap::use_skin_sprites},
-    };
+    }};
 
-    const auto tokens = split(line, ':');
-    if(tokens.size() != 2) return;
+    Fixed_tokens<2> tokens;
+    if(!tokens.split(line, ':') || tokens.size() != 2) return;
 
     if_found_parse(matcher, tokens[0], tokens[1], beatmap_);
 }
 
 void osu::Beatmap_parser::parse_editor(std::string_view line)
 {
-    static constexpr std::array<Beatmap_match_pair, 5> matcher{
+    static constexpr Key_matcher matcher{std::array<Beatmap_match_pair, 5>{
             Beatmap_match_pair{"Bookmarks", &Beatmap::bookmarks},
             Beatmap_match_pair{"DistanceSpacing", &Beatmap::distance_spacing},
             Beatmap_match_pair{"BeatDivisor", &Beatmap::beat_divisor},
             Beatmap_match_pair{"GridSize", &Beatmap::grid_size},
             Beatmap_match_pair{"TimelineZoom", &Beatmap::timeline_zoom},
-    };
+    }};
 
-    const auto tokens = split(line, ':');
-    if(tokens.size() != 2) return;
+    Fixed_tokens<2> tokens;
+    if(!tokens.split(line, ':') || tokens.size() != 2) return;
 
     if_found_parse(matcher, tokens[0], tokens[1], beatmap_);
 }
 
 void osu::Beatmap_parser::parse_metadata(std::string_view line)
 {
-    static constexpr std::array<Beatmap_match_pair, 10> matcher{
+    static constexpr Key_matcher matcher{std::array<Beatmap_match_pair, 10>{
             Beatmap_match_pair{"Title", &Beatmap::title},
             Beatmap_match_pair{"TitleUnicode", &Beatmap::title_unicode},
             Beatmap_match_pair{"Artist", &Beatmap::artist},
@@ -140,27 +126,27 @@ void osu::Beatmap_parser::parse_metadata(std::string_view line)
             Beatmap_match_pair{"Tags", &Beatmap::tags},
             Beatmap_match_pair{"BeatmapID", &Beatmap::beatmap_id},
             Beatmap_match_pair{"BeatmapSetID", &Beatmap::beatmap_set_id},
-    };
+    }};
 
-    const auto tokens = split(line, ':');
-    if(tokens.size() != 2) return;
+    Fixed_tokens<2> tokens;
+    if(!tokens.split(line, ':') || tokens.size() != 2) return;
 
     if_found_parse(matcher, tokens[0], tokens[1], beatmap_);
 }
 
 void osu::Beatmap_parser::parse_difficulty(std::string_view line)
 {
-    static constexpr std::array<Beatmap_match_pair, 6> matcher{
+    static constexpr Key_matcher matcher{std::array<Beatmap_match_pair, 6>{
             Beatmap_match_pair{"HPDrainRate", &Beatmap::hp},
             Beatmap_match_pair{"CircleSize", &Beatmap::cs},
             Beatmap_match_pair{"OverallDifficulty", &Beatmap::od},
             Beatmap_match_pair{"ApproachRate", &Beatmap::ar},
             Beatmap_match_pair{"SliderMultiplier", &Beatmap::slider_multiplier},
-            Beatmap_match_pair{"SliderTickRate ", &Beatmap::slider_tick_rate},
-    };
+            Beatmap_match_pair{"SliderTickRate", &Beatmap::slider_tick_rate},
+    }};
 
-    const auto tokens = split(line, ':');
-    if(tokens.size() != 2) return;
+    Fixed_tokens<2> tokens;
+    if(!tokens.split(line, ':') || tokens.size() != 2) return;
 
     if_found_parse(matcher, tokens[0], tokens[1], beatmap_);
 }
@@ -179,8 +165,8 @@ void osu::Beatmap_parser::parse_events(std::string_view line)
        starts_with(line, break_prefix)) {
         const std::string_view value_string = {
                 line.data() + break_prefix.length(), line.length() - break_prefix.length()};
-        auto tokens = split(value_string, ',');
-        if(tokens.size() != 2) return;
+        Fixed_tokens<2> tokens;
+        if(!tokens.split(value_string, ',') || tokens.size() != 2) return;
         std::transform(tokens.begin(), tokens.end(), tokens.begin(), ltrim_view);
         beatmap_.breaks.emplace_back(parse_value<int>(tokens[0]), parse_value<int>(tokens[1]));
     }
@@ -188,6 +174,8 @@ void osu::Beatmap_parser::parse_events(std::string_view line)
 
 void osu::Beatmap_parser::parse_timingpoints(std::string_view line)
 {
+    constexpr const auto max_timingpoint_tokens = 8;
+
     enum Timingpoint_tokens {
         time,
         duration,
@@ -198,7 +186,9 @@ void osu::Beatmap_parser::parse_timingpoints(std::string_view line)
         uninherited,
         kiai
     };
-    auto tokens = split(line, ',');
+    // Trailing tokens beyond the capacity are never read, so overflowing is fine
+    Fixed_tokens<max_timingpoint_tokens> tokens;
+    tokens.split(line, ',');
     if(tokens.size() < 8) return;
     std::transform(tokens.begin(), tokens.end(), tokens.begin(), ltrim_view);
 
@@ -208,17 +198,15 @@ void osu::Beatmap_parser::parse_timingpoints(std::string_view line)
     if(const auto bpm_value = parse_value<float>(tokens[duration]);
        bpm_value < 0) {
         point.uninherited = false;
-        const auto last_uninherited = std::find_if(beatmap_.timingpoints.crbegin(),
-                                                   beatmap_.timingpoints.crend(),
-                                                   [](auto p) { return p.uninherited; });
-        if(last_uninherited != beatmap_.timingpoints.crend()) {
+        if(parent_beat_duration_) {
             point.beat_duration = std::chrono::duration_cast<std::chrono::microseconds>(
-                    0.01f * (-bpm_value) * last_uninherited->beat_duration);
+                    0.01f * (-bpm_value) * *parent_beat_duration_);
         }
     } else {
         point.uninherited = true;
         using namespace std::chrono_literals;
         point.beat_duration = std::chrono::duration_cast<std::chrono::microseconds>(bpm_value * 1ms);
+        parent_beat_duration_ = point.beat_duration;
     }
     parse_value(tokens[meter], point.meter);
     parse_value(tokens[sample_set], point.sample_set);
@@ -227,7 +215,9 @@ void osu::Beatmap_parser::parse_timingpoints(std::string_view line)
     parse_value(tokens[kiai], point.kiai);
 
     beatmap_.timingpoints.push_back(point);
-    current_timingpoint_ = beatmap_.timingpoints.cbegin();
+    timing_cursor_.reset();
+
+    if(sink_ && sink_->timingpoint && !sink_->timingpoint(sink_->visitor, point)) stopped_ = true;
 }
 
 void osu::Beatmap_parser::parse_hitobject(std::string_view line)
@@ -235,32 +225,55 @@ void osu::Beatmap_parser::parse_hitobject(std::string_view line)
     // TODO: offset = FormatVersion < 5 ? 24 : 0;
     constexpr auto type_token = 3;
 
-    auto tokens = split(line, ',');
+    // Trailing tokens beyond the capacity are never read, so overflowing is fine
+    Fixed_tokens<max_hitobject_tokens> tokens;
+    tokens.split(line, ',');
     if(tokens.size() < 4) return;
     std::transform(tokens.begin(), tokens.end(), tokens.begin(), ltrim_view);
 
+    // Objects go to the streaming visitor if there is one, types it doesn't visit are skipped without parsing
+    const auto skipped = [this](const auto callback) { return sink_ && !(sink_->*callback); };
+    const auto store = [this](const auto callback, auto& objects, auto& object) {
+        if(!sink_) objects.push_back(std::move(object));
+        else if(!(sink_->*callback)(sink_->visitor, object))
+            stopped_ = true;
+    };
+
     const auto type = parse_value<int>(tokens[type_token]);
     if((type & static_cast<int>(Hitobject_type::circle)) != 0) {
-        if(auto&& circle = parse_circle(tokens); circle) beatmap_.circles.push_back(*circle);
+        if(skipped(&Sink::circle)) return;
+        if(auto&& circle = parse_circle(tokens); circle) store(&Sink::circle, beatmap_.circles, *circle);
     } else if((type & static_cast<int>(Hitobject_type::slider)) != 0) {
-        if(auto&& slider = parse_slider(tokens); slider) {
-            // Compute duration
-            if(current_timingpoint_ != beatmap_.timingpoints.cend()) {
-                current_timingpoint_ = next_timingpoint(current_timingpoint_, beatmap_.timingpoints.cend(), slider->time);
-                slider->duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-                        slider->length / (beatmap_.slider_multiplier * 100.f) * current_timingpoint_->beat_duration);
-            }
+        if(skipped(&Sink::slider)) return;
 
-            if(slider_paths) {
-                slider->points = sliderpath(*slider);
-                slider->distances = pathlengths(slider->points);
-                fix_slider_length(*slider);
-            }
+        // Sliders are parsed in place, streamed ones into a buffer that is reused for all of them
+        auto& slider = sink_ ? streamed_slider_ : beatmap_.sliders.emplace_back();
+        if(!parse_slider(tokens, slider)) {
+            if(!sink_) beatmap_.sliders.pop_back();
+            return;
+        }
 
-            beatmap_.sliders.push_back(*slider);
+        // Streamed sliders need their duration now, all others get it after parsing
+        if(sink_) {
+            if(!timing_cursor_) {
+                timing_index_ = Timing_index{beatmap_.timingpoints};
+                timing_cursor_.emplace(timing_index_);
+            }
+            if(!timing_index_.empty()) {
+                const auto beat_duration = timing_cursor_->seek(slider.time).effective_beat_duration;
+                slider.duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        slider.length / (beatmap_.slider_multiplier * 100.f) * beat_duration);
+            }
         }
+
+        // Without a sink, paths may be left for compute_slider_paths after parsing
+        if(slider_paths && (sink_ || path_threads == 1))
+            path_deviation_ = std::max(path_deviation_, compute_slider_path(slider, path_quality, path_cache.get()));
+
+        if(sink_ && !sink_->slider(sink_->visitor, slider)) stopped_ = true;
     } else if((type & static_cast<int>(Hitobject_type::spinner)) != 0) {
-        if(auto&& spinner = parse_spinner(tokens); spinner) beatmap_.spinners.push_back(*spinner);
+        if(skipped(&Sink::spinner)) return;
+        if(auto&& spinner = parse_spinner(tokens); spinner) store(&Sink::spinner, beatmap_.spinners, *spinner);
     }
 }
 
@@ -311,28 +324,35 @@ void osu::Beatmap_parser::parse_line(const std::string_view line)
         parse_hitobject(line);
 }
 
-std::optional<osu::Beatmap> osu::Beatmap_parser::parse_impl(Line_provider& line_provider)
+void osu::Beatmap_parser::format_line(std::string_view& line)
+{
+    if(utf16_) {
+        // We use a buffer for the line without '\0' values and point the view to that
+        utf16_line_.clear();
+        std::remove_copy(line.begin(), line.end(), std::back_inserter(utf16_line_), '\0');
+        line = utf16_line_;
+    }
+    line = trim_view(line);
+}
+
+bool osu::Beatmap_parser::parse_version(Line_provider& line_provider)
 {
     auto line = line_provider.get_line();
 
-    if(!line) return std::nullopt;
+    if(!line) return false;
 
     beatmap_ = Beatmap{};// Clear beatmap
-
-    const auto format_utf16 = maybe_parse_utfheader(*line)
-                                      ? [](std::string_view& s) {
-                                            // We use a local buffer for the line without '\0' values and point the view to that
-                                            static std::string line;
-                                            line.clear();
-                                            std::remove_copy(s.begin(), s.end(), std::back_inserter(line), '\0');
-                                            s = line;
-                                        }
-                                      : [](std::string_view&) {};// Not utf16, no handling necessary
+    stopped_ = false;
+    path_deviation_ = 0;
+    parent_beat_duration_.reset();
+    timing_cursor_.reset();
+    section_ = Section::none;
+    utf16_ = maybe_parse_utfheader(*line);
 
     const auto seek_version_string = [&] {
         const std::string_view version_prefix = "osu file format v";
         do {
-            format_utf16(*line);
+            format_line(*line);
             if(const auto pos = line->find(version_prefix);
                pos != std::string::npos) {
                 return pos + version_prefix.length();
@@ -342,31 +362,130 @@ std::optional<osu::Beatmap> osu::Beatmap_parser::parse_impl(Line_provider& line_
         return std::string::npos;
     };
 
-    if(const auto prefix_pos = seek_version_string();
-       prefix_pos == std::string::npos) {
-        return std::nullopt;
-    } else {
-        const std::string_view number_string = {
-                line->data() + prefix_pos,
-                line->length() - prefix_pos};
-
-        if(const auto ec = std::from_chars(number_string.data(),
-                                           number_string.data() + number_string.length(), beatmap_.version)
-                                   .ec;
-           ec == std::errc::invalid_argument || ec == std::errc::result_out_of_range) {
-            return std::nullopt;
-        }
+    const auto prefix_pos = seek_version_string();
+    if(prefix_pos == std::string::npos) return false;
+
+    const std::string_view number_string = {
+            line->data() + prefix_pos,
+            line->length() - prefix_pos};
+
+    const auto ec = std::from_chars(number_string.data(),
+                                    number_string.data() + number_string.length(), beatmap_.version)
+                            .ec;
+    return ec != std::errc::invalid_argument && ec != std::errc::result_out_of_range;
+}
+
+std::optional<osu::Beatmap> osu::Beatmap_parser::stream_impl(const Sink& sink, const std::string_view beatmap_content)
+{
+    sink_ = &sink;
+    auto beatmap = from_string(beatmap_content);
+    sink_ = nullptr;
+    return beatmap;
+}
+
+std::optional<osu::Beatmap> osu::Beatmap_parser::stream_impl(const Sink& sink, const std::filesystem::path& file_path)
+{
+    sink_ = &sink;
+    auto beatmap = from_file(file_path);
+    sink_ = nullptr;
+    return beatmap;
+}
+
+namespace {
+    struct Arena_visitor {
+        osu::Arena_beatmap& arena;
+
+        void operator()(const osu::Hitcircle& circle) { arena.circles.push_back(circle); }
+        void operator()(const osu::Slider& slider) { arena.sliders.emplace_back(slider); }
+        void operator()(const osu::Spinner& spinner) { arena.spinners.push_back(spinner); }
+    };
+
+    // The objects take up roughly as much memory as their text, so most maps fit into the first block
+    std::size_t arena_size(const std::uintmax_t file_size)
+    {
+        constexpr std::uintmax_t min_size = 4 * 1024;
+        constexpr std::uintmax_t max_size = 16 * 1024 * 1024;
+        return static_cast<std::size_t>(std::clamp(file_size, min_size, max_size));
     }
+}// namespace
+
+std::optional<osu::Arena_beatmap> osu::Beatmap_parser::arena_from_string(const std::string_view beatmap_content)
+{
+    auto arena = Arena_beatmap{arena_size(beatmap_content.size())};
+    auto visitor = Arena_visitor{arena};
 
-    line = line_provider.get_line();
-    while(line) {
-        format_utf16(*line);
-        *line = trim_view(*line);
+    auto header = stream_impl(make_sink(visitor), beatmap_content);
+    if(!header) return std::nullopt;
 
-        parse_line(*line);
+    arena.header = std::move(*header);
+    // Streamed durations depend on section order, the sweep doesn't
+    compute_slider_durations(arena.sliders, Timing_index{arena.header.timingpoints}, arena.header.slider_multiplier);
+    return arena;
+}
+
+std::optional<osu::Arena_beatmap> osu::Beatmap_parser::arena_from_file(const std::filesystem::path& file_path)
+{
+    std::error_code ec;
+    const auto file_size = std::filesystem::file_size(file_path, ec);
+    auto arena = Arena_beatmap{arena_size(ec ? 0 : file_size)};
+    auto visitor = Arena_visitor{arena};
+
+    auto header = stream_impl(make_sink(visitor), file_path);
+    if(!header) return std::nullopt;
+
+    arena.header = std::move(*header);
+    // Streamed durations depend on section order, the sweep doesn't
+    compute_slider_durations(arena.sliders, Timing_index{arena.header.timingpoints}, arena.header.slider_multiplier);
+    return arena;
+}
+
+std::optional<std::string_view> osu::Beatmap_parser::Line_provider::skip_to_section()
+{
+    for(auto line = get_line(); line; line = get_line()) {
+        if(const auto bracket = line->find('[');
+           bracket != std::string_view::npos && is_section_padding(line->substr(0, bracket)))
+            return line;
+    }
+    return std::nullopt;
+}
+
+std::optional<osu::Beatmap> osu::Beatmap_parser::parse_impl(Line_provider& line_provider)
+{
+    if(!parse_version(line_provider)) return std::nullopt;
+
+    auto wanted = sections;
+    if(has_sections(wanted, Section::hitobjects)) wanted = wanted | Section::difficulty | Section::timingpoints;
+    auto remaining = wanted;
+
+    auto line = line_provider.get_line();
+    while(line && !stopped_) {
+        format_line(*line);
+
+        if(starts_with(*line, "[")) {
+            remaining = remaining & ~section_;
+            if(remaining == Section::none) break;// Everything requested is done
+
+            section_ = parse_section(*line);
+            if(section_ == Section::none || !has_sections(wanted, section_)) {
+                line = line_provider.skip_to_section();
+                continue;
+            }
+        } else
+            parse_line(*line);
         line = line_provider.get_line();
     }
 
+    if(!sink_) compute_slider_durations(beatmap_);
+    if(slider_paths && !sink_ && path_threads != 1) {
+        // Small maps don't need the workers, so they are only started once a map is large enough
+        const auto threads = path_threads != 0 ? path_threads : std::max(1u, std::thread::hardware_concurrency());
+        if(beatmap_.sliders.size() >= min_parallel_sliders && (!path_pool_ || path_pool_->size() != threads))
+            path_pool_ = std::make_shared<Thread_pool>(threads);
+
+        path_deviation_ = path_pool_ ? compute_slider_paths(beatmap_.sliders, *path_pool_, path_quality, path_cache.get())
+                                     : compute_slider_paths(beatmap_.sliders, 1, path_quality, path_cache.get());
+    }
+
     return std::move(beatmap_);
 }
 
@@ -0,0 +1,80 @@
+#pragma once
+
+// Runtime instruction set detection for the vectorised kernels.
+// SIMD paths are only compiled for x86-64, where SSE2 is always available.
+
+namespace osu::cpu {
+    /// Implementations the vectorised kernels can dispatch to
+    enum class Instruction_set {
+        scalar,
+        sse2,
+        avx2
+    };
+
+    /// Whether implementations for set are compiled in and the processor can run them
+    [[nodiscard]] bool supports(Instruction_set set);
+    /// The best supported set, which the kernels dispatch to
+    [[nodiscard]] Instruction_set best_instruction_set();
+}// namespace osu::cpu
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define OSU_X86_64 1
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#include <immintrin.h>
+// MSVC allows AVX2 intrinsics in any function
+#define OSU_TARGET_AVX2
+#else
+#include <immintrin.h>
+#define OSU_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace osu::cpu {
+    [[nodiscard]] inline bool has_avx2()
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+        if(info[0] < 7) return false;
+
+        __cpuid(info, 1);
+        const auto os_saves_ymm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+        if(!os_saves_ymm) return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+
+    [[nodiscard]] inline int count_trailing_zeros(const unsigned int mask)
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctz(mask);
+#endif
+    }
+}// namespace osu::cpu
+
+#endif
+
+inline bool osu::cpu::supports(const Instruction_set set)
+{
+#ifdef OSU_X86_64
+    return set != Instruction_set::avx2 || has_avx2();
+#else
+    return set == Instruction_set::scalar;
+#endif
+}
+
+inline osu::cpu::Instruction_set osu::cpu::best_instruction_set()
+{
+    if(supports(Instruction_set::avx2)) return Instruction_set::avx2;
+    if(supports(Instruction_set::sse2)) return Instruction_set::sse2;
+    return Instruction_set::scalar;
+}
@@ -1,83 +1,117 @@
 #include "bezier.h"
-#include "osu_reader/sliderpath.h"
-#include <stack>
+#include "bezier_kernels.h"
+#include <algorithm>
+#include <cstddef>
+
+namespace {
+    // Most curves only have a few points, which plain scalar code that the compiler can inline handles best
+    struct Scalar_kernels {
+        [[nodiscard]] bool is_flat_enough(const osu::Vector2* const points, const std::size_t count) const
+        {
+            return osu::bezier::is_flat_enough_scalar(points, count, tolerance);
+        }
 
-static bool bezier_is_flat_enough(const std::vector<osu::Vector2>& points);
-static std::pair<std::vector<osu::Vector2>, std::vector<osu::Vector2>> bezier_subdivide(std::vector<osu::Vector2> points);
-static void bezier_approximate(const std::vector<osu::Vector2>& points, std::back_insert_iterator<std::vector<osu::Vector2>> output_it);
+        // Divide bezier curve into 2 separate curves of equal length
+        // If pieced together, they will result in the original curve
+        // l and r may alias points, but not midpoints
+        static void subdivide(const osu::Vector2* const points, const std::size_t count, osu::Vector2* const midpoints,
+                              osu::Vector2* const l, osu::Vector2* const r)
+        {
+            osu::bezier::subdivide_scalar(points, count, midpoints, l, r);
+        }
 
+        float tolerance;
+    };
 
-// TODO: Consider reusing buffers
-std::vector<osu::Vector2> approximate_bezier(const std::vector<osu::Vector2>& control_points)
-{
-    std::vector<osu::Vector2> points;
+    struct Vector_kernels {
+        [[nodiscard]] bool is_flat_enough(const osu::Vector2* const points, const std::size_t count) const
+        {
+            return osu::bezier::is_flat_enough(points, count, tolerance);
+        }
 
-    if(control_points.empty()) return points;
+        static void subdivide(const osu::Vector2* const points, const std::size_t count, osu::Vector2* const midpoints,
+                              osu::Vector2* const l, osu::Vector2* const r)
+        {
+            osu::bezier::subdivide(points, count, midpoints, l, r);
+        }
 
-    std::stack<std::vector<osu::Vector2>> to_flatten;
+        float tolerance;
+    };
 
-    to_flatten.push(control_points);
+    // A tolerance of 0 would subdivide forever
+    constexpr const float min_tolerance = 1e-3f;
 
-    while(!to_flatten.empty()) {
-        const auto parent = to_flatten.top();
-        to_flatten.pop();
+    template<typename Kernels>
+    void bezier_approximate(const osu::Vector2* const points, const std::size_t count, osu::Vector2* const midpoints,
+                            osu::Vector2* const halves, std::vector<osu::Vector2>& output)
+    {
+        // The left half ends where the right one starts, so they are laid out overlapping by one point
+        Kernels::subdivide(points, count, midpoints, halves, halves + count - 1);
 
-        if(bezier_is_flat_enough(parent)) {
-            bezier_approximate(parent, std::back_inserter(points));
-            continue;
-        }
-
-        // Not const to allow moving
-        auto [l, r] = bezier_subdivide(parent);
+        output.push_back(points[0]);
 
-        to_flatten.push(r);
-        to_flatten.push(l);
+        for(std::size_t i = 1; i + 1 < count; ++i) {
+            const auto index = 2 * i;
+            output.push_back(0.25f * (halves[index - 1] + 2 * halves[index] + halves[index + 1]));
+        }
     }
+}// namespace
 
-    points.push_back(control_points.back());
-    return points;
+Bezier_flattener::Bezier_flattener()
+{
+    // Sized for curves of up to 32 points and a subdivision depth of 8
+    constexpr std::size_t typical_count = 32;
+    midpoints_.reserve(typical_count + osu::bezier::scratch_padding);
+    halves_.reserve(2 * typical_count);
+    stack_.reserve(8 * typical_count);
 }
 
-static bool bezier_is_flat_enough(const std::vector<osu::Vector2>& points)
+float Bezier_flattener::flatten(const std::vector<osu::Vector2>& control_points, std::vector<osu::Vector2>& output,
+                               const float tolerance)
 {
-    constexpr const float bezier_tolerance = 0.25f;
-    for(auto i = 1; i < static_cast<int>(points.size()) - 1; ++i) {
-        if(length_squared((points[i - 1] - 2 * points[i] + points[i + 1])) > bezier_tolerance)
-            return false;
-    }
-    return true;
+    // Flatness is checked on squared lengths of second differences, like osu!lazer does
+    const auto pixels = std::max(tolerance, min_tolerance);
+    const auto flatness = pixels * pixels * 4;
+    if(control_points.size() >= osu::bezier::min_vector_count) flatten_with(control_points, output, Vector_kernels{flatness});
+    else
+        flatten_with(control_points, output, Scalar_kernels{flatness});
+    return pixels;
 }
 
-// Divide bezier curve into 2 separate curves of equal length
-// If pieced together, they will result in the original curve
-static std::pair<std::vector<osu::Vector2>, std::vector<osu::Vector2>> bezier_subdivide(std::vector<osu::Vector2> points)
+template<typename Kernels>
+void Bezier_flattener::flatten_with(const std::vector<osu::Vector2>& control_points, std::vector<osu::Vector2>& output,
+                                    const Kernels& kernels)
 {
-    const auto count = static_cast<int>(points.size());
-    std::vector<osu::Vector2> l(count), r(count);
+    if(control_points.empty()) return;
 
-    auto midpoints = points;
-    for(auto i = 0; i < count; ++i) {
-        l[i] = midpoints[0];
-        r[count - i - 1] = midpoints[count - i - 1];
+    const auto count = control_points.size();
+    midpoints_.resize(count + osu::bezier::scratch_padding);
+    halves_.resize(2 * count - 1);
 
-        for(auto j = 0; j < count - i - 1; ++j) {
-            midpoints[j] = midpoint(midpoints[j], midpoints[j + 1]);
+    stack_.assign(control_points.cbegin(), control_points.cend());
+
+    while(!stack_.empty()) {
+        const auto parent_offset = stack_.size() - count;
+
+        if(kernels.is_flat_enough(stack_.data() + parent_offset, count)) {
+            bezier_approximate<Kernels>(stack_.data() + parent_offset, count, midpoints_.data(), halves_.data(), output);
+            stack_.resize(parent_offset);
+            continue;
         }
+
+        // The right half replaces the parent and the left half goes on top, so it is flattened first.
+        // Subdivision only reads from midpoints, which makes overwriting the parent safe.
+        stack_.resize(stack_.size() + count);
+        auto* const parent = stack_.data() + parent_offset;
+        Kernels::subdivide(parent, count, midpoints_.data(), parent + count, parent);
     }
-    return {l, r};
+
+    output.push_back(control_points.back());
 }
 
-static void bezier_approximate(const std::vector<osu::Vector2>& points, std::back_insert_iterator<std::vector<osu::Vector2>> output_it)
+float approximate_bezier(const std::vector<osu::Vector2>& control_points, std::vector<osu::Vector2>& output,
+                        const float tolerance)
 {
-    const auto count = static_cast<int>(points.size());
-
-    auto [l, r] = bezier_subdivide(points);
-    l.insert(l.end(), r.begin() + 1, r.end());
-
-    *output_it++ = points[0];
-
-    for(auto i = 1; i < count - 1; ++i) {
-        const auto index = 2 * i;
-        *output_it++ = 0.25f * (l[index - 1] + 2 * l[index] + l[index + 1]);
-    }
-}
\ No newline at end of file
+    thread_local Bezier_flattener flattener;
+    return flattener.flatten(control_points, output, tolerance);
+}
@@ -1,6 +1,35 @@
 #pragma once
 
+#include <osu_reader/path_quality.h>
 #include <osu_reader/vector2.h>
 #include <vector>
 
-[[nodiscard]] std::vector<osu::Vector2> approximate_bezier(const std::vector<osu::Vector2>& control_points);
+/// Flattens bezier curves into line segments by recursive subdivision.
+/// All intermediate curves live in scratch buffers owned by the flattener, so reusing an instance
+/// stops allocating once the buffers have grown to fit the largest curve.
+class Bezier_flattener {
+public:
+    /// Reserves scratch space for typical curves up front
+    Bezier_flattener();
+
+    /// Appends the flattened curve to output, subdividing until it is flat within tolerance.
+    /// Returns the tolerance that was used, the distance the flattened curve may be off the curve by.
+    float flatten(const std::vector<osu::Vector2>& control_points, std::vector<osu::Vector2>& output,
+                 float tolerance = osu::Path_quality{}.bezier_tolerance);
+
+private:
+    template<typename Kernels>
+    void flatten_with(const std::vector<osu::Vector2>& control_points, std::vector<osu::Vector2>& output, const Kernels& kernels);
+
+    /// Curves that still need flattening, back to back. All have as many points as the input curve.
+    std::vector<osu::Vector2> stack_;
+    /// Working set of subdivision
+    std::vector<osu::Vector2> midpoints_;
+    /// Both halves of a subdivided curve, sharing the point they meet at
+    std::vector<osu::Vector2> halves_;
+};
+
+/// Appends the flattened curve to output, using a flattener that is reused by all calls on the same thread.
+/// Returns the same as Bezier_flattener::flatten.
+float approximate_bezier(const std::vector<osu::Vector2>& control_points, std::vector<osu::Vector2>& output,
+                        float tolerance = osu::Path_quality{}.bezier_tolerance);
@@ -0,0 +1,146 @@
+#include "bezier_kernels.h"
+#include "cpu_features.h"
+#include <algorithm>
+
+namespace {
+    using Flat_fn = bool (*)(const osu::Vector2*, std::size_t, float);
+    using Subdivide_fn = void (*)(const osu::Vector2*, std::size_t, osu::Vector2*, osu::Vector2*, osu::Vector2*);
+
+#ifdef OSU_X86_64
+    // Lanes are x0 y0 x1 y1 ..., so the neighbours of a point are two floats away
+    inline const float* lanes(const osu::Vector2* const points) { return &points->x; }
+    inline float* lanes(osu::Vector2* const points) { return &points->x; }
+
+    bool is_flat_sse2(const osu::Vector2* const points, const std::size_t count, const float tolerance)
+    {
+        const auto* const p = lanes(points);
+        const auto two = _mm_set1_ps(2.f);
+        const auto limit = _mm_set1_ps(tolerance);
+
+        std::size_t i = 1;
+        for(; i + 2 < count; i += 2) {
+            const auto* const f = p + 2 * i;
+            const auto d = _mm_add_ps(_mm_sub_ps(_mm_loadu_ps(f - 2), _mm_mul_ps(two, _mm_loadu_ps(f))), _mm_loadu_ps(f + 2));
+            const auto squared = _mm_mul_ps(d, d);
+            // x * x + y * y in both lanes of a point, addition is commutative so the order doesn't matter
+            const auto length = _mm_add_ps(squared, _mm_shuffle_ps(squared, squared, _MM_SHUFFLE(2, 3, 0, 1)));
+            if(_mm_movemask_ps(_mm_cmpgt_ps(length, limit)) != 0) return false;
+        }
+        return osu::bezier::is_flat_enough_scalar(points, count, tolerance, i);
+    }
+
+    // Rounds up to whole blocks into the scratch padding instead of finishing with a scalar tail.
+    // Lanes past the end only ever read their right neighbours, so the valid points are unaffected.
+    void reduce_padded_sse2(float* const p, const std::size_t count)
+    {
+        const auto half = _mm_set1_ps(0.5f);
+        for(std::size_t j = 0; j + 1 < count; j += 2) {
+            _mm_storeu_ps(p + 2 * j, _mm_mul_ps(half, _mm_add_ps(_mm_loadu_ps(p + 2 * j), _mm_loadu_ps(p + 2 * j + 2))));
+        }
+    }
+
+    void subdivide_sse2(const osu::Vector2* const points, const std::size_t count, osu::Vector2* const midpoints,
+                        osu::Vector2* const l, osu::Vector2* const r)
+    {
+        std::copy(points, points + count, midpoints);
+
+        for(std::size_t i = 0; i < count; ++i) {
+            l[i] = midpoints[0];
+            r[count - i - 1] = midpoints[count - i - 1];
+            reduce_padded_sse2(lanes(midpoints), count - i);
+        }
+    }
+
+    // The AVX2 functions keep their tails inline instead of calling the SSE2 or scalar ones,
+    // since switching between VEX and legacy SSE encoded code stalls
+    OSU_TARGET_AVX2 bool is_flat_avx2(const osu::Vector2* const points, const std::size_t count, const float tolerance)
+    {
+        const auto* const p = lanes(points);
+        const auto two = _mm256_set1_ps(2.f);
+        const auto limit = _mm256_set1_ps(tolerance);
+
+        std::size_t i = 1;
+        for(; i + 4 < count; i += 4) {
+            const auto* const f = p + 2 * i;
+            const auto d = _mm256_add_ps(_mm256_sub_ps(_mm256_loadu_ps(f - 2), _mm256_mul_ps(two, _mm256_loadu_ps(f))), _mm256_loadu_ps(f + 2));
+            const auto squared = _mm256_mul_ps(d, d);
+            const auto length = _mm256_add_ps(squared, _mm256_permute_ps(squared, _MM_SHUFFLE(2, 3, 0, 1)));
+            if(_mm256_movemask_ps(_mm256_cmp_ps(length, limit, _CMP_GT_OQ)) != 0) return false;
+        }
+        for(; i + 1 < count; ++i) {
+            if(length_squared((points[i - 1] - 2 * points[i] + points[i + 1])) > tolerance) return false;
+        }
+        return true;
+    }
+
+    OSU_TARGET_AVX2 void reduce_padded_avx2(float* const p, const std::size_t count)
+    {
+        const auto half = _mm256_set1_ps(0.5f);
+        for(std::size_t j = 0; j + 1 < count; j += 4) {
+            _mm256_storeu_ps(p + 2 * j, _mm256_mul_ps(half, _mm256_add_ps(_mm256_loadu_ps(p + 2 * j), _mm256_loadu_ps(p + 2 * j + 2))));
+        }
+    }
+
+    OSU_TARGET_AVX2 void subdivide_avx2(const osu::Vector2* const points, const std::size_t count,
+                                        osu::Vector2* const midpoints, osu::Vector2* const l, osu::Vector2* const r)
+    {
+        for(std::size_t i = 0; i < count; ++i) midpoints[i] = points[i];
+
+        for(std::size_t i = 0; i < count; ++i) {
+            l[i] = midpoints[0];
+            r[count - i - 1] = midpoints[count - i - 1];
+            reduce_padded_avx2(lanes(midpoints), count - i);
+        }
+    }
+#endif
+
+    struct Bezier_functions {
+        Flat_fn is_flat;
+        Subdivide_fn subdivide;
+    };
+
+    Bezier_functions bezier_functions(const osu::cpu::Instruction_set set)
+    {
+#ifdef OSU_X86_64
+        switch(set) {
+            case osu::cpu::Instruction_set::avx2: return {is_flat_avx2, subdivide_avx2};
+            case osu::cpu::Instruction_set::sse2: return {is_flat_sse2, subdivide_sse2};
+            case osu::cpu::Instruction_set::scalar: break;
+        }
+#else
+        static_cast<void>(set);
+#endif
+        return {[](const osu::Vector2* points, std::size_t count, float tolerance) {
+                    return osu::bezier::is_flat_enough_scalar(points, count, tolerance);
+                },
+                osu::bezier::subdivide_scalar};
+    }
+
+    const Bezier_functions& bezier_functions()
+    {
+        static const auto functions = bezier_functions(osu::cpu::best_instruction_set());
+        return functions;
+    }
+}// namespace
+
+bool osu::bezier::is_flat_enough(const Vector2* const points, const std::size_t count, const float tolerance)
+{
+    return bezier_functions().is_flat(points, count, tolerance);
+}
+
+void osu::bezier::subdivide(const Vector2* const points, const std::size_t count, Vector2* const midpoints,
+                            Vector2* const l, Vector2* const r)
+{
+    bezier_functions().subdivide(points, count, midpoints, l, r);
+}
+
+bool osu::bezier::is_flat_enough(const Vector2* const points, const std::size_t count, const float tolerance, const cpu::Instruction_set set)
+{
+    return bezier_functions(set).is_flat(points, count, tolerance);
+}
+
+void osu::bezier::subdivide(const Vector2* const points, const std::size_t count, Vector2* const midpoints,
+                            Vector2* const l, Vector2* const r, const cpu::Instruction_set set)
+{
+    bezier_functions(set).subdivide(points, count, midpoints, l, r);
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <osu_reader/vector2.h>
+
+namespace osu::cpu {
+    enum class Instruction_set;// From cpu_features.h
+}
+
+// Kernels of the bezier flattener. Vector2 arrays are processed as interleaved x and y lanes,
+// so one SSE2 register holds two points and one AVX2 register four.
+// The implementation (AVX2, SSE2 or scalar) is picked once at runtime. Nothing contracts into fused multiply-adds
+// and the per point operation order is the one of the Vector2 operators, so all paths give bit-identical results.
+namespace osu::bezier {
+    /// Points past count that subdivision scratch space must have room for
+    constexpr std::size_t scratch_padding = 4;
+    /// Curves with fewer points are faster with plain scalar code, vectorisation doesn't pay off for them
+    constexpr std::size_t min_vector_count = 6;
+
+    /// Whether every second difference of the points has a squared length of at most tolerance
+    [[nodiscard]] bool is_flat_enough(const Vector2* points, std::size_t count, float tolerance);
+
+    /// De Casteljau subdivision at t = 0.5 into the left and right halves, each with count points.
+    /// Uses midpoints as scratch space of count + scratch_padding points, which must not alias anything else.
+    /// The halves may alias the input.
+    void subdivide(const Vector2* points, std::size_t count, Vector2* midpoints, Vector2* l, Vector2* r);
+
+    /// The functions above with the implementation for set instead of the best one, which lets tests compare them.
+    /// set has to be supported.
+    [[nodiscard]] bool is_flat_enough(const Vector2* points, std::size_t count, float tolerance, cpu::Instruction_set set);
+    void subdivide(const Vector2* points, std::size_t count, Vector2* midpoints, Vector2* l, Vector2* r, cpu::Instruction_set set);
+
+    // Scalar versions, inline since short curves call them directly. They also finish the tails of the vector versions.
+
+    /// is_flat_enough for the second differences around points first to count - 2
+    [[nodiscard]] inline bool is_flat_enough_scalar(const Vector2* const points, const std::size_t count, const float tolerance,
+                                                    std::size_t first = 1)
+    {
+        for(; first + 1 < count; ++first) {
+            if(length_squared((points[first - 1] - 2 * points[first] + points[first + 1])) > tolerance) return false;
+        }
+        return true;
+    }
+
+    inline void subdivide_scalar(const Vector2* const points, const std::size_t count, Vector2* const midpoints,
+                                 Vector2* const l, Vector2* const r)
+    {
+        std::copy(points, points + count, midpoints);
+
+        // Each reduction round yields the next point of both halves.
+        // Ascending order reads each successor before it is overwritten.
+        for(std::size_t i = 0; i < count; ++i) {
+            l[i] = midpoints[0];
+            r[count - i - 1] = midpoints[count - i - 1];
+            for(std::size_t j = 0; j + i + 1 < count; ++j) midpoints[j] = midpoint(midpoints[j], midpoints[j + 1]);
+        }
+    }
+}// namespace osu::bezier
@@ -1,31 +1,66 @@
 #include "catmull.h"
+#include <algorithm>
+#include <cmath>
 
-static osu::Vector2 catmull_find_point(const osu::Vector2& v1, const osu::Vector2& v2, const osu::Vector2& v3, const osu::Vector2& v4, double t)
-{
-    const auto t2 = t * t;
-    const auto t3 = t * t2;
+namespace {
+    // Upper bound of points per segment, the fixed detail used before subdivision became adaptive
+    constexpr const int catmull_max_detail = 50;
 
-    return {
-            static_cast<float>(0.5 * (2 * v2.x + (-v1.x + v3.x) * t + (2 * v1.x - 5 * v2.x + 4 * v3.x - v4.x) * t2 + (-v1.x + 3 * v2.x - 3 * v3.x + v4.x) * t3)),
-            static_cast<float>(0.5 * (2 * v2.y + (-v1.y + v3.y) * t + (2 * v1.y - 5 * v2.y + 4 * v3.y - v4.y) * t2 + (-v1.y + 3 * v2.y - 3 * v3.y + v4.y) * t3))};
-}
+    // Segment between v2 and v3 as the polynomial a + b t + c t^2 + d t^3
+    struct Catmull_segment {
+        Catmull_segment(const osu::Vector2& v1, const osu::Vector2& v2, const osu::Vector2& v3, const osu::Vector2& v4)
+            : a{v2},
+              b{0.5f * (v3 - v1)},
+              c{0.5f * (2 * v1 - 5 * v2 + 4 * v3 - v4)},
+              d{0.5f * (3 * v2 - 3 * v3 + v4 - v1)}
+        {
+        }
+
+        // Largest length of P'', which is linear in t, so it is at one of the ends
+        [[nodiscard]] float max_curvature() const
+        {
+            return std::max(length(2 * c), length(2 * c + 6 * d));
+        }
+
+        [[nodiscard]] osu::Vector2 at(const float t) const
+        {
+            return a + t * (b + t * (c + t * d));
+        }
 
-std::vector<osu::Vector2> approximate_catmull(const std::vector<osu::Vector2>& control_points)
+        // A chord over a parameter interval h deviates at most max |P''| h^2 / 8 from the curve
+        [[nodiscard]] int detail(const float tolerance) const
+        {
+            const auto max_curvature = this->max_curvature();
+            if(max_curvature <= 0) return 1;
+            if(tolerance <= 0) return catmull_max_detail;
+
+            const auto steps = std::ceil(std::sqrt(max_curvature / (8 * tolerance)));
+            return static_cast<int>(std::clamp(steps, 1.f, static_cast<float>(catmull_max_detail)));
+        }
+
+        osu::Vector2 a, b, c, d;
+    };
+}// namespace
+
+float approximate_catmull(const std::vector<osu::Vector2>& control_points, std::vector<osu::Vector2>& output,
+                          const float tolerance)
 {
-    const constexpr auto catmull_detail = 50;
-    std::vector<osu::Vector2> points;
-    points.reserve((control_points.size() - 1) * catmull_detail * 2);
+    const auto count = static_cast<int>(control_points.size());
+    if(count < 2) return 0;
 
-    for(auto i = 0; i < static_cast<int>(control_points.size()) - 1; ++i) {
+    auto deviation = 0.f;
+    for(auto i = 0; i < count - 1; ++i) {
         const auto v1 = i > 0 ? control_points[i - 1] : control_points[i];
         const auto v2 = control_points[i];
-        const auto v3 = i < static_cast<int>(control_points.size()) - 1 ? control_points[i + 1] : v2 + v2 - v1;
-        const auto v4 = i < static_cast<int>(control_points.size()) - 2 ? control_points[i + 2] : v3 + v3 - v2;
+        const auto v3 = control_points[i + 1];
+        const auto v4 = i < count - 2 ? control_points[i + 2] : v3 + v3 - v2;
 
-        for(int c = 0; c < catmull_detail; ++c) {
-            points.push_back(catmull_find_point(v1, v2, v3, v4, static_cast<float>(c) / catmull_detail));
-            points.push_back(catmull_find_point(v1, v2, v3, v4, static_cast<float>(c + 1) / catmull_detail));
-        }
+        // Every segment starts where the previous one ended, so only the very last end point is added separately
+        const auto segment = Catmull_segment{v1, v2, v3, v4};
+        const auto detail = segment.detail(tolerance);
+        deviation = std::max(deviation, segment.max_curvature() / static_cast<float>(8 * detail * detail));
+        for(auto step = 0; step < detail; ++step) output.push_back(segment.at(static_cast<float>(step) / detail));
     }
-    return points;
-}
\ No newline at end of file
+    output.push_back(control_points.back());
+    return deviation;
+}
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <osu_reader/path_quality.h>
 #include <osu_reader/vector2.h>
 #include <vector>
 
-[[nodiscard]] std::vector<osu::Vector2> approximate_catmull(const std::vector<osu::Vector2>& control_points);
+/// Appends the approximated spline to output. Points per segment adapt to its curvature, and every point is added once.
+/// The polyline stays within tolerance of the spline unless a segment hits the limit of 50 points.
+/// Returns the largest distance any segment may be off the spline by, which is above tolerance only for segments at the limit.
+float approximate_catmull(const std::vector<osu::Vector2>& control_points, std::vector<osu::Vector2>& output,
+                          float tolerance = osu::Path_quality{}.catmull_tolerance);
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "thread_pool.h"
+#include <cstddef>
+#include <osu_reader/sliderpath.h>
+#include <vector>
+
+namespace osu {
+    /// Below this many sliders, compute_slider_paths stays on the calling thread, starting the work costs more than it saves
+    constexpr std::size_t min_parallel_sliders = 256;
+
+    /// compute_slider_paths on the workers of pool, which lets callers keep their threads across calls
+    float compute_slider_paths(std::vector<osu::Slider>& sliders, Thread_pool& pool, const Path_quality& quality,
+                               Slider_path_cache* cache);
+}// namespace osu
@@ -2,7 +2,7 @@
 #include "parse_string.h"
 #include <array>
 
-std::optional<osu::Hitcircle> parse_circle(const std::vector<std::string_view>& tokens)
+std::optional<osu::Hitcircle> parse_circle(const osu::Token_span tokens)
 {
     enum Circle_tokens {
         x,
@@ -19,7 +19,13 @@ std::optional<osu::Hitcircle> parse_circle(const std::vector<std::string_view>&
 
     return circle;
 }
-std::optional<osu::Slider> parse_slider(const std::vector<std::string_view>& tokens)
+std::optional<osu::Slider> parse_slider(const osu::Token_span tokens)
+{
+    osu::Slider slider{};
+    if(!parse_slider(tokens, slider)) return std::nullopt;
+    return slider;
+}
+bool parse_slider(const osu::Token_span tokens, osu::Slider& slider)
 {
 
     enum Slider_tokens {
@@ -36,19 +42,27 @@ std::optional<osu::Slider> parse_slider(const std::vector<std::string_view>& tok
         extras
     };
 
-    if(tokens.size() < 8) return std::nullopt;
+    if(tokens.size() < 8) return false;
 
-    osu::Slider slider{};
+    // Reset everything except for the buffers
+    slider.time = slider.duration = {};
+    slider.repeat = 0;
+    slider.length = 0.f;
+    slider.points.clear();
+    slider.distances.clear();
 
     osu::parse_value(tokens[time], slider.time);
     osu::parse_value(tokens[repeat], slider.repeat);
     osu::parse_value(tokens[length], slider.length);
 
     // Parse slider type and points
-    auto sub_tokens = osu::split(tokens[slider_data], '|');
-    if(sub_tokens.size() < 2) return std::nullopt;// Format: B|380:120|332:96|332:96|304:124
-    std::transform(sub_tokens.begin(), sub_tokens.end(),
-                   sub_tokens.begin(), osu::ltrim_view);
+    // Format: B|380:120|332:96|332:96|304:124
+    // The control points are tokenized one at a time since there is no upper bound on their count
+    auto sub_tokens = osu::Tokenizer{tokens[slider_data], '|'};
+    const auto type_token = sub_tokens.next();
+    auto point_token = sub_tokens.next();
+    if(!type_token || !point_token) return false;
+    const auto slider_type_token = osu::ltrim_view(*type_token);
 
     const constexpr auto valid_slider_type = [](const char slider_type) {
         const static constexpr std::array<osu::Slider::Slider_type, 4> slider_types{
@@ -58,47 +72,50 @@ std::optional<osu::Slider> parse_slider(const std::vector<std::string_view>& tok
             return slider_type == static_cast<char>(e);
         });
     };
-    if(sub_tokens[0].empty() || !valid_slider_type(sub_tokens[0][0])) return std::nullopt;
+    if(slider_type_token.empty() || !valid_slider_type(slider_type_token[0])) return false;
+
+    // Segments left over from a previous slider are cleared and reused, so their point buffers stay allocated
+    auto used_segments = std::size_t{0};
+    const auto new_segment = [&](const osu::Slider::Slider_type type) -> osu::Slider::Segment& {
+        if(used_segments == slider.segments.size()) slider.segments.emplace_back();
+        auto& segment = slider.segments[used_segments++];
+        segment.points.clear();
+        segment.type = type;
+        return segment;
+    };
 
     // Transform points to curve segments
-    slider.segments.emplace_back();
-    slider.segments.back().type = slider.type = static_cast<osu::Slider::Slider_type>(sub_tokens[0].front());
+    slider.type = static_cast<osu::Slider::Slider_type>(slider_type_token.front());
+    new_segment(slider.type).points.push_back({osu::parse_value<float>(tokens[x]), osu::parse_value<float>(tokens[y])});
 
-    slider.segments.back().points.push_back({osu::parse_value<float>(tokens[x]), osu::parse_value<float>(tokens[y])});
-
-    for(auto it = sub_tokens.cbegin() + 1; it != sub_tokens.cend(); ++it) {
-        if(it->length() == 1) {// new slider type begin. Is this actually a thing though??
-            slider.segments.emplace_back();
-            slider.segments.back().type = static_cast<osu::Slider::Slider_type>(it->front());
+    for(; point_token; point_token = sub_tokens.next()) {
+        const auto token = osu::ltrim_view(*point_token);
+        if(token.length() == 1) {// new slider type begin. Is this actually a thing though??
+            new_segment(static_cast<osu::Slider::Slider_type>(token.front()));
             continue;
         }
 
         // TODO: Max coordinate values of 131072
-#if false
-        osu::Point point{};
-        const auto pos = std::from_chars(it->data(), it->data() + it->length(), point.x).ptr;
-        std::from_chars(pos + 1, it->data() + it->length(), point.y);
-#else// TODO: remove when from_chars is more widely supported
         osu::Vector2 point{};
-        std::size_t pos = 0;
-        point.x = std::stof(&it->front(), &pos);
-        point.y = std::stof(&it->front() + pos + 1, nullptr);
-#endif
+        const auto* const token_end = token.data() + token.length();
+        if(const auto* const pos = osu::parse_float(token.data(), token_end, point.x).ptr;
+           pos != token_end)
+            osu::parse_float(pos + 1, token_end, point.y);
 
         // Duplicate points means start of new segment
-        if(!slider.segments.back().points.empty()) {
-            if(const auto last_point = slider.segments.back().points.back();
+        auto& segment = slider.segments[used_segments - 1];
+        if(!segment.points.empty()) {
+            if(const auto last_point = segment.points.back();
                last_point.x == point.x && last_point.y == point.y) {
 
-                slider.segments.emplace_back();
-                slider.segments.back().type = slider.type;
-                slider.segments.back().points.push_back(point);
+                new_segment(slider.type).points.push_back(point);
                 continue;
             }
         }
 
-        slider.segments.back().points.push_back(point);
+        segment.points.push_back(point);
     }
+    slider.segments.resize(used_segments);
 
     // Slider segment edge rules for perfect curves
     for(auto& segment : slider.segments) {
@@ -111,9 +128,9 @@ std::optional<osu::Slider> parse_slider(const std::vector<std::string_view>& tok
         }
     }
 
-    return slider;
+    return true;
 }
-std::optional<osu::Spinner> parse_spinner(const std::vector<std::string_view>& tokens)
+std::optional<osu::Spinner> parse_spinner(const osu::Token_span tokens)
 {
     enum Spinner_tokens {
         x,
@@ -2,9 +2,15 @@
 
 #include <optional>
 #include <osu_reader/hitobject.h>
+#include <osu_reader/string_stuff.h>
 #include <string_view>
 #include <vector>
 
-[[nodiscard]] std::optional<osu::Hitcircle> parse_circle(const std::vector<std::string_view>& tokens);
-[[nodiscard]] std::optional<osu::Slider> parse_slider(const std::vector<std::string_view>& tokens);
-[[nodiscard]] std::optional<osu::Spinner> parse_spinner(const std::vector<std::string_view>& tokens);
+/// Upper bound on the comma separated tokens of a hitobject line that are looked at
+constexpr const auto max_hitobject_tokens = 16;
+
+[[nodiscard]] std::optional<osu::Hitcircle> parse_circle(osu::Token_span tokens);
+[[nodiscard]] std::optional<osu::Slider> parse_slider(osu::Token_span tokens);
+/// Parses into an existing slider, reusing the memory of its segments. Returns false if the slider is invalid.
+bool parse_slider(osu::Token_span tokens, osu::Slider& slider);
+[[nodiscard]] std::optional<osu::Spinner> parse_spinner(osu::Token_span tokens);
@@ -1,7 +1,9 @@
 
 #include "perfect_circle.h"
 #include "bezier.h"
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <optional>
 #include <stack>
 
@@ -57,12 +59,15 @@ std::optional<Circular_properties> circular_properties(const std::vector<osu::Ve
     return Circular_properties{theta_start, theta_range, dir, r, centre};
 }
 
-std::vector<osu::Vector2> approximate_perfect(const std::vector<osu::Vector2>& control_points)
+float approximate_perfect(const std::vector<osu::Vector2>& control_points, std::vector<osu::Vector2>& output,
+                         const osu::Path_quality& quality)
 {
-    constexpr const auto circular_arc_tolerance = 0.1;
+    // A tolerance of 0 would ask for infinitely many points
+    const auto circular_arc_tolerance = std::max(static_cast<double>(quality.arc_tolerance), 1e-3);
+    constexpr const std::size_t renormalise_interval = 16;
 
     const auto properties = circular_properties(control_points);
-    if(!properties) return approximate_bezier(control_points);
+    if(!properties) return approximate_bezier(control_points, output, quality.bezier_tolerance);
 
     // To quote peppy:
     // We select the amount of points for the approximation by requiring the discrete curvature
@@ -73,16 +78,42 @@ std::vector<osu::Vector2> approximate_perfect(const std::vector<osu::Vector2>& c
     const auto point_count = 2 * properties->radius <= circular_arc_tolerance
                                      ? 2
                                      : std::max(2., std::ceil(properties->theta_range / (2 * std::acos(1 - circular_arc_tolerance / properties->radius))));
-
-    std::vector<osu::Vector2> points;
-    for(auto i = 0; i < point_count; ++i) {
-        const auto fract = static_cast<double>(i) / (point_count - 1);
-        const auto theta = properties->theta_start + properties->direction * fract * properties->theta_range;
-        points.push_back(properties->centre + properties->radius * osu::Vector2{static_cast<float>(std::cos(theta)), static_cast<float>(std::sin(theta))});
+    // Radii too large for the tolerance to make a difference ask for infinitely many points
+    if(!std::isfinite(point_count)) return approximate_bezier(control_points, output, quality.bezier_tolerance);
+
+    const auto count = static_cast<std::size_t>(point_count);
+    const auto start = output.size();
+    if(output.capacity() < start + count) output.reserve(std::max(start + count, 2 * output.capacity()));
+
+    // Instead of a sine and cosine per point, the unit vector towards the current point is rotated by a fixed step
+    const auto step = properties->direction * properties->theta_range / (point_count - 1);
+    const auto step_cos = std::cos(step);
+    const auto step_sin = std::sin(step);
+    auto x = std::cos(properties->theta_start);
+    auto y = std::sin(properties->theta_start);
+
+    const auto at = [&properties](const double x, const double y) {
+        return properties->centre + properties->radius * osu::Vector2{static_cast<float>(x), static_cast<float>(y)};
+    };
+    for(std::size_t i = 0; i + 1 < count; ++i) {
+        output.push_back(at(x, y));
+
+        const auto rotated_x = x * step_cos - y * step_sin;
+        y = x * step_sin + y * step_cos;
+        x = rotated_x;
+
+        // Rounding errors make the length drift, renormalising keeps it at 1
+        if(i % renormalise_interval == renormalise_interval - 1) {
+            const auto scale = 1 / std::sqrt(x * x + y * y);
+            x *= scale;
+            y *= scale;
+        }
     }
+    // The end point is computed directly, so it doesn't carry accumulated rotation error
+    const auto theta_end = properties->theta_start + properties->direction * properties->theta_range;
+    output.push_back(at(std::cos(theta_end), std::sin(theta_end)));
 
-    // Failure for some reason. Maybe worth logging to investigate? Same behaviour as lazer
-    if(points.empty()) return approximate_bezier(control_points);
-
-    return points;
+    // Sagitta of the chords. Like lazer, the point count allows one chord more than the points are spread over,
+    // so this can be above the tolerance for arcs of few points.
+    return static_cast<float>(properties->radius * (1 - std::cos(step / 2)));
 }
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <osu_reader/path_quality.h>
 #include <osu_reader/vector2.h>
 #include <vector>
 
-[[nodiscard]] std::vector<osu::Vector2> approximate_perfect(const std::vector<osu::Vector2>& control_points);
+/// Appends the approximated arc to output, or the bezier approximation if the points don't form a proper circle.
+/// Uses the arc tolerance of quality, and its bezier tolerance for the fallback.
+/// Returns the distance the approximation may be off the arc or bezier curve by.
+float approximate_perfect(const std::vector<osu::Vector2>& control_points, std::vector<osu::Vector2>& output,
+                         const osu::Path_quality& quality = {});
@@ -0,0 +1,226 @@
+#include "osu_reader/slider_position.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+namespace {
+    // Index i of the segment with distances[i] <= distance < distances[i + 1], clamped to the valid segments.
+    // The search gallops outwards from hint first, so it's constant time for nearby queries and logarithmic otherwise.
+    std::size_t find_segment(const std::vector<float>& distances, const float distance, const std::size_t hint)
+    {
+        const auto last = distances.size() - 2;
+        auto low = std::min(hint, last);
+        auto high = low + 1;
+
+        if(distance >= distances[high]) {
+            std::size_t step = 1;
+            while(high < distances.size() - 1 && distance >= distances[high]) {
+                low = high;
+                high = std::min(high + step, distances.size() - 1);
+                step *= 2;
+            }
+        } else if(distance < distances[low]) {
+            std::size_t step = 1;
+            while(low > 0 && distance < distances[low]) {
+                high = low;
+                low = low > step ? low - step : 0;
+                step *= 2;
+            }
+        }
+
+        // distances[low] <= distance < distances[high] unless clamped at an end
+        const auto upper = std::upper_bound(distances.cbegin() + static_cast<std::ptrdiff_t>(low) + 1,
+                                            distances.cbegin() + static_cast<std::ptrdiff_t>(high), distance);
+        return std::min(static_cast<std::size_t>(upper - distances.cbegin()) - 1, last);
+    }
+
+    osu::Vector2 interpolate(const std::vector<osu::Vector2>& points, const std::vector<float>& distances,
+                             const std::size_t segment, const float distance)
+    {
+        const auto start = distances[segment];
+        const auto span = distances[segment + 1] - start;
+        if(span <= 0) return points[segment];
+
+        const auto t = std::clamp((distance - start) / span, 0.f, 1.f);
+        return lerp(points[segment], points[segment + 1], t);
+    }
+
+    osu::Vector2 head(const osu::Slider& slider)
+    {
+        if(!slider.points.empty()) return slider.points.front();
+        if(!slider.segments.empty() && !slider.segments.front().points.empty()) return slider.segments.front().points.front();
+        return {0, 0};
+    }
+
+    bool has_path(const osu::Slider& slider)
+    {
+        return slider.points.size() >= 2 && slider.distances.size() == slider.points.size();
+    }
+
+    // Distance along a path of length at progress through all repeats
+    float progress_distance(const osu::Slider& slider, const float length, const float progress)
+    {
+        const auto spans = std::max(slider.repeat, 1);
+        const auto position = std::clamp(progress, 0.f, 1.f) * static_cast<float>(spans);
+        const auto span = std::min(static_cast<int>(position), spans - 1);
+
+        auto local = position - static_cast<float>(span);
+        if(span % 2 == 1) local = 1 - local;// Repeats go backwards
+        return local * length;
+    }
+
+    float progress_distance(const osu::Slider& slider, const float progress)
+    {
+        return progress_distance(slider, slider.distances.back(), progress);
+    }
+
+    float time_progress(const osu::Slider& slider, const std::chrono::milliseconds time)
+    {
+        // duration is the time of one slide
+        const auto total = slider.duration.count() * std::max(slider.repeat, 1);
+        if(total <= 0) return time < slider.time ? 0.f : 1.f;
+        return static_cast<float>(time.count() - slider.time.count()) / static_cast<float>(total);
+    }
+
+    template<typename Input, typename To_progress>
+    void positions_at(const osu::Slider& slider, const std::vector<Input>& inputs, std::vector<osu::Vector2>& positions,
+                      const To_progress& to_progress)
+    {
+        positions.resize(inputs.size());
+        if(!has_path(slider)) {
+            std::fill(positions.begin(), positions.end(), head(slider));
+            return;
+        }
+
+        std::size_t segment = 0;
+        for(std::size_t i = 0; i < inputs.size(); ++i) {
+            const auto distance = progress_distance(slider, to_progress(inputs[i]));
+            segment = find_segment(slider.distances, distance, segment);
+            positions[i] = interpolate(slider.points, slider.distances, segment, distance);
+        }
+    }
+}// namespace
+
+osu::Vector2 osu::position_at_distance(const std::vector<Vector2>& points, const std::vector<float>& distances, const float distance)
+{
+    if(points.empty()) return {0, 0};
+    if(points.size() < 2 || distances.size() != points.size()) return points.front();
+
+    const auto segment = find_segment(distances, distance, 0);
+    return interpolate(points, distances, segment, distance);
+}
+
+osu::Vector2 osu::position_at_progress(const Slider& slider, const float progress)
+{
+    if(!has_path(slider)) return head(slider);
+    return position_at_distance(slider.points, slider.distances, progress_distance(slider, progress));
+}
+
+osu::Vector2 osu::position_at_time(const Slider& slider, const std::chrono::milliseconds time)
+{
+    return position_at_progress(slider, time_progress(slider, time));
+}
+
+void osu::positions_at_progress(const Slider& slider, const std::vector<float>& progress, std::vector<Vector2>& positions)
+{
+    positions_at(slider, progress, positions, [](const float p) { return p; });
+}
+
+void osu::positions_at_times(const Slider& slider, const std::vector<std::chrono::milliseconds>& times, std::vector<Vector2>& positions)
+{
+    positions_at(slider, times, positions, [&slider](const std::chrono::milliseconds time) { return time_progress(slider, time); });
+}
+
+void osu::resample_path(const std::vector<Vector2>& points, const std::vector<float>& distances, const std::size_t count,
+                        std::vector<Vector2>& output)
+{
+    output.clear();
+    if(count == 0) return;
+    if(points.size() < 2 || distances.size() != points.size()) {
+        output.resize(count, points.empty() ? Vector2{0, 0} : points.front());
+        return;
+    }
+
+    output.reserve(count);
+    const auto length = distances.back();
+    const auto last = count - 1;
+    std::size_t segment = 0;
+    for(std::size_t i = 0; i < count; ++i) {
+        // Computed like fractions of the length so the last point lands exactly on the end
+        const auto distance = last == 0 ? 0.f : length * (static_cast<float>(i) / static_cast<float>(last));
+        segment = find_segment(distances, distance, segment);
+        output.push_back(interpolate(points, distances, segment, distance));
+    }
+}
+
+osu::Arc_length_table::Arc_length_table(std::vector<Vector2> points, std::vector<float> distances, const std::size_t buckets)
+    : points_{std::move(points)}, distances_{std::move(distances)}
+{
+    if(points_.size() < 2 || distances_.size() != points_.size()) {
+        // Nothing to index, lookups return the first point
+        points_.resize(std::min<std::size_t>(points_.size(), 1));
+        distances_.assign(points_.size(), 0.f);
+        return;
+    }
+
+    const auto last = static_cast<std::uint32_t>(points_.size() - 2);
+    const auto length = distances_.back();
+    if(length <= 0) {
+        // Everything is at distance 0, which the searches place on the last segment
+        buckets_.assign(1, last);
+        return;
+    }
+
+    const auto bucket_count = buckets == 0 ? points_.size() - 1 : buckets;
+    buckets_per_distance_ = static_cast<float>(bucket_count) / length;
+
+    // One sweep, segments and bucket starts both increase
+    buckets_.resize(bucket_count);
+    std::uint32_t segment = 0;
+    for(std::size_t i = 0; i < bucket_count; ++i) {
+        const auto start = static_cast<float>(i) / buckets_per_distance_;
+        while(segment < last && distances_[segment + 1] <= start) ++segment;
+        buckets_[i] = segment;
+    }
+}
+
+osu::Arc_length_table::Arc_length_table(const Slider& slider, const std::size_t buckets)
+    : Arc_length_table{has_path(slider) ? slider.points : std::vector<Vector2>{head(slider)},
+                       has_path(slider) ? slider.distances : std::vector<float>{0}, buckets}
+{
+}
+
+osu::Vector2 osu::Arc_length_table::at_distance(const float distance) const
+{
+    if(points_.empty()) return {0, 0};
+    if(buckets_.empty()) return points_.front();
+
+    const auto bucket = std::min(static_cast<std::size_t>(std::max(distance * buckets_per_distance_, 0.f)), buckets_.size() - 1);
+    auto segment = static_cast<std::size_t>(buckets_[bucket]);
+    // The bucket start can round past distance
+    while(segment > 0 && distances_[segment] > distance) --segment;
+    const auto last = points_.size() - 2;
+    while(segment < last && distances_[segment + 1] <= distance) ++segment;
+    return interpolate(points_, distances_, segment, distance);
+}
+
+osu::Vector2 osu::Arc_length_table::at_fraction(const float fraction) const
+{
+    return at_distance(std::clamp(fraction, 0.f, 1.f) * length());
+}
+
+void osu::Arc_length_table::resample(const std::size_t count, std::vector<Vector2>& output) const
+{
+    resample_path(points_, distances_, count, output);
+}
+
+osu::Vector2 osu::position_at_progress(const Slider& slider, const Arc_length_table& table, const float progress)
+{
+    return table.at_distance(progress_distance(slider, table.length(), progress));
+}
+
+osu::Vector2 osu::position_at_time(const Slider& slider, const Arc_length_table& table, const std::chrono::milliseconds time)
+{
+    return position_at_progress(slider, table, time_progress(slider, time));
+}
@@ -1,54 +1,143 @@
 #include "osu_reader/sliderpath.h"
+#include "osu_reader/slider_path_cache.h"
 #include "bezier.h"
 #include "catmull.h"
+#include "parallel_sliderpath.h"
 #include "perfect_circle.h"
 #include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <utility>
 
 // Heavily inspired by https://github.com/ppy/osu-framework/blob/99786238a02e0d6b69da86dd52e5506ee8ec0566/osu.Framework/Utils/PathApproximator.cs
 
-static std::vector<osu::Vector2> approximate_linear(const std::vector<osu::Vector2>& control_points)
-{
-    return control_points;
-}
+namespace {
+    void approximate_linear(const std::vector<osu::Vector2>& control_points, std::vector<osu::Vector2>& output)
+    {
+        output.insert(output.end(), control_points.cbegin(), control_points.cend());
+    }
 
+    // Removes repeated points and points in the middle of a straight line in a single in-place pass.
+    // Every point is compared against the last two that were kept, so a run of collinear points collapses to its ends.
+    void compact_path(std::vector<osu::Vector2>& path)
+    {
+        if(path.empty()) return;
 
-std::vector<osu::Vector2> osu::sliderpath(const osu::Slider& slider)
-{
-    std::vector<osu::Vector2> path;
+        std::size_t kept = 1;
+        // Normal of the vector from the last kept point to the one before it, only meaningful once two points are kept
+        auto direction = osu::Vector2{0, 0};
+        for(std::size_t i = 1; i < path.size(); ++i) {
+            const auto point = path[i];
+            if(point == path[kept - 1]) continue;
 
-    for(const auto& segment : slider.segments) {
-        const auto points = [](const auto& segment) {
-            switch(segment.type) {
-                case osu::Slider::Slider_type::linear:
-                    return approximate_linear(segment.points);
-                case osu::Slider::Slider_type::perfect:
-                    return approximate_perfect(segment.points);
-                case osu::Slider::Slider_type::bezier:
-                    return approximate_bezier(segment.points);
-                case osu::Slider::Slider_type::catmull:
-                    return approximate_catmull(segment.points);
+            const auto next_direction = normal(path[kept - 1] - point);
+            if(kept >= 2 && next_direction == direction) {
+                // The last kept point lies on the line to this one
+                path[kept - 1] = point;
+                direction = normal(path[kept - 2] - point);
+            } else {
+                path[kept++] = point;
+                direction = next_direction;
             }
-            // Maybe log in the future?
-            return segment.points;
-        }(segment);
-
-        path.insert(path.end(), points.begin(), points.end());
+        }
+        path.resize(kept);
     }
 
-    // Remove duplicates
-    path.erase(std::unique(path.begin(), path.end()), path.end());
 
-    // Erase multiple points in same direction
-    for(auto it = path.cbegin(); it != path.cend(); ++it) {
-        if(normal(*(it - 2) - *(it - 1)) == normal(*(it - 1) - *it)) {
-            // erase invalidates later iterators, so reassign
-            it = path.erase(it - 1);
+    // Ramer-Douglas-Peucker simplification in place.
+    // Returns the largest distance between a removed point and the segment that replaced it.
+    float simplify_path(std::vector<osu::Vector2>& path, const float tolerance)
+    {
+        if(tolerance <= 0 || path.size() < 3) return 0;
+
+        // Ranges are processed from a stack rather than recursively, so long paths can't overflow the call stack
+        thread_local std::vector<char> keep;
+        thread_local std::vector<std::pair<std::size_t, std::size_t>> ranges;
+        keep.assign(path.size(), false);
+        keep.front() = keep.back() = true;
+        ranges.assign(1, {0, path.size() - 1});
+
+        const auto tolerance_sq = tolerance * tolerance;
+        auto deviation_sq = 0.f;
+        while(!ranges.empty()) {
+            const auto [first, last] = ranges.back();
+            ranges.pop_back();
+
+            // Squared distances to the segment from first to last, which saves a square root per point
+            const auto a = path[first];
+            const auto ab = path[last] - a;
+            const auto inverse_length_sq = length_squared(ab) > 0 ? 1 / length_squared(ab) : 0.f;
+            auto max_distance_sq = 0.f;
+            auto farthest = first;
+            for(auto i = first + 1; i < last; ++i) {
+                const auto t = std::clamp(dot(path[i] - a, ab) * inverse_length_sq, 0.f, 1.f);
+                if(const auto d = length_squared(path[i] - (a + t * ab)); d > max_distance_sq) {
+                    max_distance_sq = d;
+                    farthest = i;
+                }
+            }
+
+            if(max_distance_sq > tolerance_sq) {
+                keep[farthest] = true;
+                ranges.emplace_back(farthest, last);
+                ranges.emplace_back(first, farthest);
+            } else
+                deviation_sq = std::max(deviation_sq, max_distance_sq);
+        }
+
+        std::size_t kept = 0;
+        for(std::size_t i = 0; i < path.size(); ++i) {
+            if(keep[i]) path[kept++] = path[i];
         }
+        path.resize(kept);
+        return std::sqrt(deviation_sq);
     }
+}// namespace
 
+std::vector<osu::Vector2> osu::sliderpath(const osu::Slider& slider)
+{
+    std::vector<osu::Vector2> path;
+    sliderpath(slider, path);
     return path;
 }
 
+void osu::sliderpath(const osu::Slider& slider, std::vector<osu::Vector2>& path)
+{
+    sliderpath(slider, path, Path_quality{});
+}
+
+float osu::sliderpath(const osu::Slider& slider, std::vector<osu::Vector2>& path, const Path_quality& quality)
+{
+    path.clear();
+
+    // Linear segments are exact, curves are off by at most what their approximation reports
+    auto deviation = 0.f;
+    for(const auto& segment : slider.segments) {
+        switch(segment.type) {
+            case osu::Slider::Slider_type::linear:
+                approximate_linear(segment.points, path);
+                break;
+            case osu::Slider::Slider_type::perfect:
+                deviation = std::max(deviation, approximate_perfect(segment.points, path, quality));
+                break;
+            case osu::Slider::Slider_type::bezier:
+                deviation = std::max(deviation, approximate_bezier(segment.points, path, quality.bezier_tolerance));
+                break;
+            case osu::Slider::Slider_type::catmull:
+                deviation = std::max(deviation, approximate_catmull(segment.points, path, quality.catmull_tolerance));
+                break;
+            default:
+                // Maybe log in the future?
+                approximate_linear(segment.points, path);
+                break;
+        }
+    }
+
+    compact_path(path);
+    // Simplification moves the approximated path, which adds to the approximation error
+    return deviation + simplify_path(path, quality.simplify_tolerance);
+}
+
 std::vector<float> osu::pathlengths(const std::vector<osu::Vector2>& points)
 {
     std::vector<float> distances{0};
@@ -63,29 +152,80 @@ std::vector<float> osu::pathlengths(const std::vector<osu::Vector2>& points)
     return distances;
 }
 
+float osu::compute_slider_path(osu::Slider& slider, const Path_quality& quality, Slider_path_cache* const cache)
+{
+    if(cache) return cache->compute(slider, quality);
+
+    const auto deviation = sliderpath(slider, slider.points, quality);
+    slider.distances = pathlengths(slider.points);
+    fix_slider_length(slider);
+    return deviation;
+}
+
+float osu::compute_slider_paths(std::vector<osu::Slider>& sliders, std::size_t threads, const Path_quality& quality,
+                                Slider_path_cache* const cache)
+{
+    if(threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    if(threads == 1 || sliders.size() < min_parallel_sliders) {
+        auto deviation = 0.f;
+        for(auto& slider : sliders) deviation = std::max(deviation, compute_slider_path(slider, quality, cache));
+        return deviation;
+    }
+
+    Thread_pool pool{threads};
+    return compute_slider_paths(sliders, pool, quality, cache);
+}
+
+float osu::compute_slider_paths(std::vector<osu::Slider>& sliders, Thread_pool& pool, const Path_quality& quality,
+                                Slider_path_cache* const cache)
+{
+    auto deviation = 0.f;
+    if(pool.size() == 1 || sliders.size() < min_parallel_sliders) {
+        for(auto& slider : sliders) deviation = std::max(deviation, compute_slider_path(slider, quality, cache));
+        return deviation;
+    }
+
+    // Several chunks per thread even out sliders of very different cost
+    const auto chunk_size = std::max<std::size_t>(16, sliders.size() / (pool.size() * 8));
+    std::mutex deviation_mutex;
+    pool.parallel_for(sliders.size(), chunk_size, [&](const std::size_t begin, const std::size_t end) {
+        auto chunk_deviation = 0.f;
+        for(auto i = begin; i < end; ++i) chunk_deviation = std::max(chunk_deviation, compute_slider_path(sliders[i], quality, cache));
+
+        const std::lock_guard lock{deviation_mutex};
+        deviation = std::max(deviation, chunk_deviation);
+    });
+    return deviation;
+}
+
 void osu::fix_slider_length(osu::Slider& slider)
 {
-    if(slider.distances.empty()) return;
-    if(slider.distances.size() != slider.points.size()) return;// TODO: Log or something?
+    fix_path_length(slider.points, slider.distances, slider.length);
+}
+
+void osu::fix_path_length(std::vector<osu::Vector2>& points, std::vector<float>& distances, const float length)
+{
+    if(distances.empty()) return;
+    if(distances.size() != points.size()) return;// TODO: Log or something?
 
-    if(slider.distances.back() > slider.length) {
-        while(slider.points.size() >= 2 && *(slider.distances.end() - 2) >= slider.length) {
-            slider.distances.pop_back();
-            slider.points.pop_back();
+    if(distances.back() > length) {
+        while(points.size() >= 2 && *(distances.end() - 2) >= length) {
+            distances.pop_back();
+            points.pop_back();
         }
-        if(slider.points.size() >= 2 && slider.distances.back() > slider.length) {// Interpolate within the last segment
-            const auto direction = normal(slider.points.back() - *(slider.points.end() - 2));
-            slider.distances.pop_back();
-            slider.points.pop_back();
-            const auto length = slider.length - slider.distances.back();
-            slider.distances.push_back(slider.length);
-            slider.points.push_back(slider.points.back() + length * direction);
+        if(points.size() >= 2 && distances.back() > length) {// Interpolate within the last segment
+            const auto direction = normal(points.back() - *(points.end() - 2));
+            distances.pop_back();
+            points.pop_back();
+            const auto remaining = length - distances.back();
+            distances.push_back(length);
+            points.push_back(points.back() + remaining * direction);
         }
     }
-    if(slider.distances.back() < slider.length && slider.points.size() >= 2) {// Lengthen last segment
-        const auto direction = normal(slider.points.back() - *(slider.points.end() - 2));
-        const auto length = slider.length - slider.distances.back();
-        slider.distances.push_back(slider.length);
-        slider.points.push_back(slider.points.back() + length * direction);
+    if(distances.back() < length && points.size() >= 2) {// Lengthen last segment
+        const auto direction = normal(points.back() - *(points.end() - 2));
+        const auto remaining = length - distances.back();
+        distances.push_back(length);
+        points.push_back(points.back() + remaining * direction);
     }
 }
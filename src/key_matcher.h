@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace osu {
+    /// Constant time lookup from key to value over a fixed set of keys.
+    /// A perfect hash over length, first, middle and last character is searched for at compile time,
+    /// so a lookup costs one hash and at most one string comparison.
+    template<typename Value, std::size_t N>
+    class Key_matcher {
+    public:
+        using Pair = std::pair<const std::string_view, Value>;
+
+        constexpr explicit Key_matcher(const std::array<Pair, N>& pairs) : pairs_{pairs}
+        {
+            for(std::uint32_t seed = 1; seed < max_seed; ++seed) {
+                if(try_seed(seed)) return;
+            }
+            // Only reachable with duplicate keys, makes constant evaluation fail
+            throw std::logic_error{"No perfect hash found for keys"};
+        }
+
+        [[nodiscard]] constexpr const Value* find(const std::string_view key) const
+        {
+            if(key.empty()) return nullptr;
+
+            const auto index = slots_[hash(key, seed_) & (table_size - 1)];
+            if(index == empty_slot || pairs_[index].first != key) return nullptr;
+            return &pairs_[index].second;
+        }
+
+    private:
+        static constexpr std::size_t table_size = [] {
+            std::size_t size = 1;
+            while(size < 2 * N) size *= 2;
+            return size;
+        }();
+        static constexpr std::uint8_t empty_slot = 0xFF;
+        static constexpr std::uint32_t max_seed = 1 << 16;
+        static_assert(N < empty_slot, "Too many keys for the slot index type");
+
+        static constexpr std::uint32_t hash(const std::string_view key, const std::uint32_t seed)
+        {
+            auto h = seed;
+            const auto mix = [&h](const std::uint32_t v) {
+                h = (h ^ v) * 0x01000193u;
+            };
+            mix(static_cast<std::uint32_t>(key.size()));
+            mix(static_cast<unsigned char>(key.front()));
+            mix(static_cast<unsigned char>(key[key.size() / 2]));
+            mix(static_cast<unsigned char>(key.back()));
+            return h ^ (h >> 15);
+        }
+
+        constexpr bool try_seed(const std::uint32_t seed)
+        {
+            for(auto& slot : slots_) slot = empty_slot;
+
+            for(std::size_t i = 0; i < N; ++i) {
+                auto& slot = slots_[hash(pairs_[i].first, seed) & (table_size - 1)];
+                if(slot != empty_slot) return false;
+                slot = static_cast<std::uint8_t>(i);
+            }
+            seed_ = seed;
+            return true;
+        }
+
+        std::array<Pair, N> pairs_;
+        std::array<std::uint8_t, table_size> slots_{};
+        std::uint32_t seed_ = 0;
+    };
+
+    template<typename Value, std::size_t N>
+    Key_matcher(const std::array<std::pair<const std::string_view, Value>, N>&) -> Key_matcher<Value, N>;
+}// namespace osu
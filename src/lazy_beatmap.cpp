@@ -0,0 +1,157 @@
+#include "osu_reader/lazy_beatmap.h"
+#include "mapped_file.h"
+#include "osu_reader/string_stuff.h"
+#include "osu_reader/timing_index.h"
+#include "scan.h"
+#include "string_line_provider.h"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+struct osu::Lazy_beatmap::Impl {
+    std::optional<Mapped_file> mapped;
+    std::string owned;
+    std::string_view content;
+
+    /// Body of every section, headers excluded
+    std::vector<std::pair<Beatmap_section, std::string_view>> ranges;
+    Beatmap_section available = Beatmap_section::none;
+    Beatmap_section parsed = Beatmap_section::none;
+
+    Beatmap_parser parser;
+};
+
+osu::Lazy_beatmap::Lazy_beatmap(std::unique_ptr<Impl> impl) : impl_{std::move(impl)} {}
+osu::Lazy_beatmap::Lazy_beatmap(Lazy_beatmap&&) noexcept = default;
+osu::Lazy_beatmap& osu::Lazy_beatmap::operator=(Lazy_beatmap&&) noexcept = default;
+osu::Lazy_beatmap::~Lazy_beatmap() = default;
+
+std::optional<osu::Lazy_beatmap> osu::Lazy_beatmap::from_file(const std::filesystem::path& file_path)
+{
+    auto impl = std::make_unique<Impl>();
+
+    if(auto mapped = Mapped_file{file_path}; mapped.is_mapped()) {
+        impl->content = mapped.view();
+        impl->mapped = std::move(mapped);
+    } else {
+        std::ifstream file{file_path, std::ios::binary};
+        if(!file.is_open()) return std::nullopt;
+        impl->owned.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+        impl->content = impl->owned;
+    }
+
+    return from_impl(std::move(impl));
+}
+
+std::optional<osu::Lazy_beatmap> osu::Lazy_beatmap::from_string(std::string beatmap_content)
+{
+    auto impl = std::make_unique<Impl>();
+    impl->owned = std::move(beatmap_content);
+    impl->content = impl->owned;
+
+    return from_impl(std::move(impl));
+}
+
+std::optional<osu::Lazy_beatmap> osu::Lazy_beatmap::from_impl(std::unique_ptr<Impl> impl)
+{
+    auto& content = impl->content;
+    auto& parser = impl->parser;
+
+    // Byte offsets only line up with the lines once utf16 zero bytes are gone, so strip them all up front
+    if(Beatmap_parser::maybe_parse_utfheader(content)) {
+        std::string stripped;
+        stripped.reserve(content.size() / 2);
+        std::remove_copy(content.begin(), content.end(), std::back_inserter(stripped), '\0');
+        impl->owned = std::move(stripped);
+        impl->mapped.reset();
+        content = impl->owned;
+    }
+
+    auto provider = Beatmap_parser::String_line_provider{content};
+    if(!parser.parse_version(provider)) return std::nullopt;
+    parser.utf16_ = false;// Already taken care of
+
+    // Index pass: a '[' that starts a line begins a new section
+    const auto close_section = [&](const Beatmap_section section, const std::size_t begin, const std::size_t end) {
+        if(section == Beatmap_section::none) return;
+        impl->ranges.emplace_back(section, content.substr(begin, end - begin));
+        impl->available = impl->available | section;
+    };
+
+    auto section = Beatmap_section::none;
+    auto section_start = provider.position();
+    for(auto pos = section_start; pos < content.size();) {
+        const auto bracket = scan::find(content, '[', pos);
+        if(bracket == std::string_view::npos) break;
+        pos = bracket + 1;
+
+        const auto newline = content.rfind('\n', bracket);
+        const auto line_start = newline == std::string_view::npos ? 0 : newline + 1;
+        const auto starts_line = is_section_padding(content.substr(line_start, bracket - line_start));
+        if(!starts_line || line_start < section_start) continue;
+
+        const auto line_end = std::min(scan::find(content, '\n', bracket), content.size());
+        close_section(section, section_start, line_start);
+
+        section = Beatmap_parser::parse_section(trim_view(content.substr(bracket, line_end - bracket)));
+        section_start = pos = std::min(line_end + 1, content.size());
+    }
+    close_section(section, section_start, content.size());
+
+    return Lazy_beatmap{std::move(impl)};
+}
+
+const osu::Beatmap& osu::Lazy_beatmap::get(Beatmap_section sections)
+{
+    auto& parser = impl_->parser;
+
+    // Slider durations are computed from these after parsing hitobjects
+    if(has_sections(sections, Beatmap_section::hitobjects))
+        sections = sections | Beatmap_section::difficulty | Beatmap_section::timingpoints;
+
+    const auto todo = sections & ~impl_->parsed;
+    impl_->parsed = impl_->parsed | sections;
+
+    // Parse in file order, so that dependencies are resolved first
+    constexpr std::array<Beatmap_section, 8> section_order{
+            Beatmap_section::general, Beatmap_section::editor, Beatmap_section::metadata,
+            Beatmap_section::difficulty, Beatmap_section::events, Beatmap_section::timingpoints,
+            Beatmap_section::colours, Beatmap_section::hitobjects};
+
+    parser.slider_paths = slider_paths;
+    parser.path_quality = path_quality;
+    for(const auto section : section_order) {
+        if(!has_sections(todo, section)) continue;
+
+        for(const auto& [range_section, range] : impl_->ranges) {
+            if(range_section != section) continue;
+
+            parser.section_ = section;
+            auto provider = Beatmap_parser::String_line_provider{range};
+            for(auto line = provider.get_line(); line; line = provider.get_line()) {
+                parser.format_line(*line);
+                parser.parse_line(*line);
+            }
+        }
+    }
+    if(has_sections(todo, Beatmap_section::hitobjects)) compute_slider_durations(parser.beatmap_);
+
+    return parser.beatmap_;
+}
+
+osu::Beatmap_section osu::Lazy_beatmap::available() const
+{
+    return impl_->available;
+}
+
+osu::Beatmap_section osu::Lazy_beatmap::parsed() const
+{
+    return impl_->parsed;
+}
+
+int osu::Lazy_beatmap::version() const
+{
+    return impl_->parser.beatmap_.version;
+}
@@ -0,0 +1,25 @@
+#include "osu_reader/lazy_slider_paths.h"
+#include "osu_reader/sliderpath.h"
+
+osu::Lazy_slider_paths::Lazy_slider_paths(const std::vector<Slider>& sliders, const Path_quality& quality)
+    : sliders_{&sliders}, quality_{quality}, slots_{std::make_unique<Slot[]>(sliders.size())}
+{
+}
+
+const osu::Lazy_slider_paths::Path& osu::Lazy_slider_paths::operator[](const std::size_t index) const
+{
+    auto& slot = slots_[index];
+    std::call_once(slot.once, [&] {
+        const auto& slider = (*sliders_)[index];
+        slot.path.deviation = sliderpath(slider, slot.path.points, quality_);
+        slot.path.distances = pathlengths(slot.path.points);
+        fix_path_length(slot.path.points, slot.path.distances, slider.length);
+        slot.done.store(true, std::memory_order_release);
+    });
+    return slot.path;
+}
+
+bool osu::Lazy_slider_paths::computed(const std::size_t index) const
+{
+    return slots_[index].done.load(std::memory_order_acquire);
+}
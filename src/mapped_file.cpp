@@ -0,0 +1,84 @@
+#include "mapped_file.h"
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+osu::Mapped_file::Mapped_file(const std::filesystem::path& file_path)
+{
+#ifdef _WIN32
+    const auto file = CreateFileW(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if(file == INVALID_HANDLE_VALUE) return;
+
+    LARGE_INTEGER file_size{};
+    // Zero sized files can't be mapped
+    if(GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0) {
+        if(const auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+           mapping != nullptr) {
+            // The view keeps the mapping alive, so both handles can be closed right away
+            data_ = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            if(data_) size_ = static_cast<std::size_t>(file_size.QuadPart);
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+#else
+    const auto fd = open(file_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if(fd < 0) return;
+
+    struct stat file_stat {};
+    // Only regular, non-empty files can be mapped
+    if(fstat(fd, &file_stat) == 0 && S_ISREG(file_stat.st_mode) && file_stat.st_size > 0) {
+        const auto size = static_cast<std::size_t>(file_stat.st_size);
+        if(auto* const address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+           address != MAP_FAILED) {
+            madvise(address, size, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(address);
+            size_ = size;
+        }
+    }
+    // The mapping stays valid after closing the descriptor
+    close(fd);
+#endif
+}
+
+osu::Mapped_file::Mapped_file(Mapped_file&& other) noexcept
+    : data_{std::exchange(other.data_, nullptr)}, size_{std::exchange(other.size_, 0)}
+{}
+
+osu::Mapped_file& osu::Mapped_file::operator=(Mapped_file&& other) noexcept
+{
+    if(this != &other) {
+        unmap();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+osu::Mapped_file::~Mapped_file()
+{
+    unmap();
+}
+
+void osu::Mapped_file::unmap()
+{
+    if(!data_) return;
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+#else
+    munmap(const_cast<char*>(data_), size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
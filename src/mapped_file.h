@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+namespace osu {
+    /// Read-only memory mapping of a whole file. Empty if the file could not be mapped,
+    /// in which case callers should fall back to regular stream reading.
+    class Mapped_file {
+    public:
+        explicit Mapped_file(const std::filesystem::path& file_path);
+        Mapped_file(const Mapped_file&) = delete;
+        Mapped_file& operator=(const Mapped_file&) = delete;
+        Mapped_file(Mapped_file&& other) noexcept;
+        Mapped_file& operator=(Mapped_file&& other) noexcept;
+        ~Mapped_file();
+
+        [[nodiscard]] bool is_mapped() const { return data_ != nullptr; }
+        [[nodiscard]] std::string_view view() const { return {data_, size_}; }
+
+    private:
+        void unmap();
+
+        const char* data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+}// namespace osu
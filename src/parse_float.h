@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+#if !defined(__cpp_lib_to_chars) || __cpp_lib_to_chars < 201611L
+#include <locale>
+#include <sstream>
+#include <string>
+#endif
+
+namespace osu {
+    namespace detail {
+        template<typename Float>
+        struct Exact_float_limits;
+
+        // Largest mantissa and power of ten that are both exactly representable
+        template<>
+        struct Exact_float_limits<float> {
+            static constexpr std::uint64_t max_mantissa = std::uint64_t{1} << 24;
+            static constexpr int max_exponent = 10;
+        };
+        template<>
+        struct Exact_float_limits<double> {
+            static constexpr std::uint64_t max_mantissa = std::uint64_t{1} << 53;
+            static constexpr int max_exponent = 22;
+        };
+
+        template<typename Float>
+        constexpr Float power_of_ten(const int exponent)
+        {
+            constexpr std::array<Float, 23> powers{
+                    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+            return powers[exponent];
+        }
+
+        /// Fallback for values outside the exact fast path. Correctly rounded, locale independent and doesn't throw.
+        template<typename Float>
+        std::from_chars_result parse_float_slow(const char* first, const char* last, Float& value)
+        {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+            // from_chars doesn't accept a leading '+' unlike stof, which was used before
+            const auto* const start = first != last && *first == '+' ? first + 1 : first;
+            const auto result = std::from_chars(start, last, value);
+            if(result.ec == std::errc::invalid_argument) return {first, result.ec};
+            return result;
+#else
+            // Toolchains without floating point from_chars get the classic locale stream parser
+            std::istringstream stream{std::string{first, last}};
+            stream.imbue(std::locale::classic());
+            Float parsed{};
+            if(!(stream >> parsed)) return {first, std::errc::invalid_argument};
+            value = parsed;
+            const auto consumed = stream.eof() ? last - first : static_cast<std::ptrdiff_t>(stream.tellg());
+            return {first + consumed, std::errc{}};
+#endif
+        }
+    }// namespace detail
+
+    /// Parses a decimal floating point number like std::from_chars. Locale independent, doesn't allocate or throw,
+    /// and results are correctly rounded. On failure, value is left untouched.
+    /// Short numbers with few significant digits, which is nearly everything in osu files,
+    /// are computed exactly with a single multiplication or division.
+    template<typename Float>
+    std::from_chars_result parse_float(const char* const first, const char* const last, Float& value)
+    {
+        static_assert(std::is_same_v<Float, float> || std::is_same_v<Float, double>);
+        using Limits = detail::Exact_float_limits<Float>;
+
+        const auto* it = first;
+        const auto negative = it != last && *it == '-';
+        if(it != last && (*it == '-' || *it == '+')) ++it;
+
+        std::uint64_t mantissa = 0;
+        auto digits = 0;
+        auto exponent = 0;
+        auto any_digits = false;
+
+        const auto is_digit = [](const char c) { return c >= '0' && c <= '9'; };
+        const auto add_digit = [&](const char c) {
+            any_digits = true;
+            if(mantissa == 0 && c == '0') return;// Leading zeros aren't significant
+            if(++digits <= 19) mantissa = mantissa * 10 + static_cast<std::uint64_t>(c - '0');
+        };
+
+        for(; it != last && is_digit(*it); ++it) add_digit(*it);
+        if(it != last && *it == '.') {
+            ++it;
+            for(; it != last && is_digit(*it); ++it) {
+                add_digit(*it);
+                --exponent;
+            }
+        }
+        if(!any_digits) return detail::parse_float_slow(first, last, value);// Maybe inf or nan
+
+        if(it != last && (*it == 'e' || *it == 'E')) {
+            // The exponent is only consumed if it contains digits
+            auto exp_it = it + 1;
+            const auto exp_negative = exp_it != last && *exp_it == '-';
+            if(exp_it != last && (*exp_it == '-' || *exp_it == '+')) ++exp_it;
+            if(exp_it != last && is_digit(*exp_it)) {
+                auto explicit_exponent = 0;
+                for(; exp_it != last && is_digit(*exp_it); ++exp_it) {
+                    if(explicit_exponent < 10000) explicit_exponent = explicit_exponent * 10 + (*exp_it - '0');
+                }
+                exponent += exp_negative ? -explicit_exponent : explicit_exponent;
+                it = exp_it;
+            }
+        }
+
+        if(digits > 19 || mantissa > Limits::max_mantissa || exponent < -Limits::max_exponent || exponent > Limits::max_exponent) {
+            return detail::parse_float_slow(first, last, value);
+        }
+
+        // Both operands are exact, so the single rounding step of the operation gives the correctly rounded result
+        auto result = static_cast<Float>(mantissa);
+        if(exponent < 0) result /= detail::power_of_ten<Float>(-exponent);
+        else
+            result *= detail::power_of_ten<Float>(exponent);
+        value = negative ? -result : result;
+        return {it, std::errc{}};
+    }
+}// namespace osu
@@ -2,6 +2,7 @@
 
 #include "osu_reader/beatmap.h"
 #include "osu_reader/string_stuff.h"
+#include "parse_float.h"
 #include <charconv>
 #include <chrono>
 #include <filesystem>
@@ -15,18 +16,16 @@ namespace osu {
         std::from_chars(value_string.data(), value_string.data() + value_string.length(), value);
     }
 
-    // TODO: remove these when floating point from_chars is more widely supported
-    // TODO: stof and co can throw
     template<>
     inline void parse_value<>(std::string_view value_string, float& value)
     {
-        value = std::stof(std::string{value_string});
+        parse_float(value_string.data(), value_string.data() + value_string.length(), value);
     }
 
     template<>
     inline void parse_value<>(std::string_view value_string, double& value)
     {
-        value = std::stod(std::string{value_string});
+        parse_float(value_string.data(), value_string.data() + value_string.length(), value);
     }
 
     template<>
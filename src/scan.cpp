@@ -0,0 +1,138 @@
+#include "scan.h"
+#include "cpu_features.h"
+
+namespace {
+    using Find_fn = std::size_t (*)(std::string_view, char, std::size_t);
+    using Find_all_fn = std::size_t (*)(std::string_view, char, std::uint32_t*, std::size_t);
+
+    std::size_t find_scalar(const std::string_view s, const char c, const std::size_t pos)
+    {
+        // char_traits::find is usually memchr, which is already reasonably fast
+        return s.find(c, pos);
+    }
+
+    std::size_t find_all_scalar(const std::string_view s, const char c, std::uint32_t* const positions, const std::size_t capacity)
+    {
+        std::size_t count = 0;
+        for(std::size_t i = 0; i < s.size() && count < capacity; ++i) {
+            if(s[i] == c) positions[count++] = static_cast<std::uint32_t>(i);
+        }
+        return count;
+    }
+
+#ifdef OSU_X86_64
+    // Each block is compared at once and the resulting bit mask is walked from its lowest bit,
+    // so a single pass over the block yields all of its matches
+    std::size_t find_sse2(const std::string_view s, const char c, std::size_t pos)
+    {
+        const auto needle = _mm_set1_epi8(c);
+        for(; pos + 16 <= s.size(); pos += 16) {
+            const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s.data() + pos));
+            if(const auto mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+               mask != 0)
+                return pos + osu::cpu::count_trailing_zeros(mask);
+        }
+        return find_scalar(s, c, pos);
+    }
+
+    std::size_t find_all_sse2(const std::string_view s, const char c, std::uint32_t* const positions, const std::size_t capacity)
+    {
+        const auto needle = _mm_set1_epi8(c);
+        std::size_t count = 0;
+        std::size_t pos = 0;
+        for(; pos + 16 <= s.size(); pos += 16) {
+            const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s.data() + pos));
+            auto mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+            for(; mask != 0; mask &= mask - 1) {
+                if(count == capacity) return count;
+                positions[count++] = static_cast<std::uint32_t>(pos + osu::cpu::count_trailing_zeros(mask));
+            }
+        }
+        for(; pos < s.size() && count < capacity; ++pos) {
+            if(s[pos] == c) positions[count++] = static_cast<std::uint32_t>(pos);
+        }
+        return count;
+    }
+
+    OSU_TARGET_AVX2 std::size_t find_avx2(const std::string_view s, const char c, std::size_t pos)
+    {
+        const auto needle = _mm256_set1_epi8(c);
+        for(; pos + 32 <= s.size(); pos += 32) {
+            const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s.data() + pos));
+            if(const auto mask = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+               mask != 0)
+                return pos + osu::cpu::count_trailing_zeros(mask);
+        }
+        return find_sse2(s, c, pos);
+    }
+
+    OSU_TARGET_AVX2 std::size_t find_all_avx2(const std::string_view s, const char c, std::uint32_t* const positions, const std::size_t capacity)
+    {
+        const auto needle = _mm256_set1_epi8(c);
+        std::size_t count = 0;
+        std::size_t pos = 0;
+        for(; pos + 32 <= s.size(); pos += 32) {
+            const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s.data() + pos));
+            auto mask = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+            for(; mask != 0; mask &= mask - 1) {
+                if(count == capacity) return count;
+                positions[count++] = static_cast<std::uint32_t>(pos + osu::cpu::count_trailing_zeros(mask));
+            }
+        }
+        if(count == capacity) return count;
+
+        // Hand the tail to the SSE2 version and shift its results
+        const auto tail_count = find_all_sse2(s.substr(pos), c, positions + count, capacity - count);
+        for(auto i = count; i < count + tail_count; ++i) positions[i] += static_cast<std::uint32_t>(pos);
+        return count + tail_count;
+    }
+#endif
+
+    struct Scan_functions {
+        Find_fn find;
+        Find_all_fn find_all;
+    };
+
+    Scan_functions scan_functions(const osu::cpu::Instruction_set set)
+    {
+#ifdef OSU_X86_64
+        switch(set) {
+            case osu::cpu::Instruction_set::avx2: return {find_avx2, find_all_avx2};
+            case osu::cpu::Instruction_set::sse2: return {find_sse2, find_all_sse2};
+            case osu::cpu::Instruction_set::scalar: break;
+        }
+#else
+        static_cast<void>(set);
+#endif
+        return {find_scalar, find_all_scalar};
+    }
+
+    const Scan_functions& scan_functions()
+    {
+        static const auto functions = scan_functions(osu::cpu::best_instruction_set());
+        return functions;
+    }
+}// namespace
+
+std::size_t osu::scan::find(const std::string_view s, const char c, const std::size_t pos)
+{
+    if(pos >= s.size()) return std::string_view::npos;
+    return scan_functions().find(s, c, pos);
+}
+
+std::size_t osu::scan::find_all(const std::string_view s, const char c, std::uint32_t* const positions, const std::size_t capacity)
+{
+    return scan_functions().find_all(s, c, positions, capacity);
+}
+
+std::size_t osu::scan::find(const std::string_view s, const char c, const std::size_t pos, const cpu::Instruction_set set)
+{
+    if(pos >= s.size()) return std::string_view::npos;
+    return scan_functions(set).find(s, c, pos);
+}
+
+std::size_t osu::scan::find_all(const std::string_view s, const char c, std::uint32_t* const positions, const std::size_t capacity,
+                                const cpu::Instruction_set set)
+{
+    return scan_functions(set).find_all(s, c, positions, capacity);
+}
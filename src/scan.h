@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace osu::cpu {
+    enum class Instruction_set;// From cpu_features.h
+}
+
+// Vectorised byte scanning used by the tokenizers.
+// The implementation (AVX2, SSE2 or scalar) is picked once at runtime.
+namespace osu::scan {
+    /// Position of the first c in s at or after pos, std::string_view::npos if there is none
+    [[nodiscard]] std::size_t find(std::string_view s, char c, std::size_t pos = 0);
+
+    /// Writes the positions of the first occurrences of c in s to positions, at most capacity many.
+    /// Returns the number of positions written, so a return value of capacity means there may be more.
+    std::size_t find_all(std::string_view s, char c, std::uint32_t* positions, std::size_t capacity);
+
+    /// The functions above with the implementation for set instead of the best one, which lets tests compare them.
+    /// set has to be supported.
+    [[nodiscard]] std::size_t find(std::string_view s, char c, std::size_t pos, cpu::Instruction_set set);
+    std::size_t find_all(std::string_view s, char c, std::uint32_t* positions, std::size_t capacity, cpu::Instruction_set set);
+}// namespace osu::scan
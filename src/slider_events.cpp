@@ -0,0 +1,130 @@
+#include "osu_reader/slider_events.h"
+#include "osu_reader/slider_position.h"
+#include "osu_reader/sliderpath.h"
+#include "osu_reader/timing_index.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    using Event_type = osu::Slider_event::Type;
+
+    // Same limits as osu!lazer, which keep broken sliders from generating millions of ticks
+    constexpr double max_slider_length = 100000;
+    constexpr double min_tick_time_from_end = 10'000;// In microseconds
+
+    struct Slider_timing {
+        double span_duration;// In microseconds
+        double tick_distance;// 0 if there are no ticks
+        double min_tick_distance_from_end;
+    };
+
+    Slider_timing slider_timing(const osu::Beatmap& beatmap, const osu::Slider& slider, osu::Timing_index::Cursor& cursor)
+    {
+        const auto timing = cursor.seek(slider.time);
+        const auto beat_duration = static_cast<double>(timing.effective_beat_duration.count());
+        if(beat_duration <= 0 || beatmap.slider_multiplier <= 0) {
+            // Without a usable timing point, the parsed duration is all there is to go by
+            return {std::chrono::duration<double, std::micro>(slider.duration).count(), 0, 0};
+        }
+
+        // Inherited timing points already have their slider velocity applied to beat_duration
+        const auto scoring_distance = 100. * beatmap.slider_multiplier;
+        const auto velocity = scoring_distance / beat_duration;// Pixels per microsecond
+        const auto parent_beat_duration = static_cast<double>(timing.beat_duration.count());
+
+        auto tick_distance = 0.;
+        if(beatmap.slider_tick_rate > 0 && parent_beat_duration > 0) {
+            // Before version 8, ticks didn't move with slider velocity
+            tick_distance = beatmap.version < 8 ? scoring_distance / beatmap.slider_tick_rate
+                                                : velocity * parent_beat_duration / beatmap.slider_tick_rate;
+        }
+        return {slider.length / velocity, tick_distance, velocity * min_tick_time_from_end};
+    }
+
+    /// Calls emit(type, time, distance) for every event of slider in time order, distance being along the path
+    template<typename Emit>
+    void generate_events(const osu::Slider& slider, const Slider_timing& timing, const Emit& emit)
+    {
+        const auto spans = std::max(slider.repeat, 1);
+        const auto length = std::min(static_cast<double>(slider.length), max_slider_length);
+        const auto start = static_cast<double>(std::chrono::microseconds{slider.time}.count());
+
+        emit(Event_type::head, start, 0.);
+
+        const auto tick_distance = std::clamp(timing.tick_distance, 0., length);
+        std::size_t ticks = 0;
+        if(tick_distance > 0) {
+            while((ticks + 1) * tick_distance <= length && (ticks + 1) * tick_distance < length - timing.min_tick_distance_from_end)
+                ++ticks;
+        }
+
+        for(auto span = 0; span < spans; ++span) {
+            const auto span_start = start + span * timing.span_duration;
+            const auto reversed = span % 2 == 1;
+
+            // Reversed spans run from the end of the path back to its start
+            for(std::size_t i = 1; i <= ticks; ++i) {
+                const auto tick = reversed ? ticks + 1 - i : i;
+                const auto distance = static_cast<double>(tick) * tick_distance;
+                const auto progress = distance / length;
+                emit(Event_type::tick, span_start + (reversed ? 1 - progress : progress) * timing.span_duration, distance);
+            }
+
+            if(span + 1 < spans) emit(Event_type::repeat, span_start + timing.span_duration, reversed ? 0. : length);
+        }
+
+        emit(Event_type::tail, start + spans * timing.span_duration, spans % 2 == 1 ? length : 0.);
+    }
+}// namespace
+
+std::vector<osu::Slider_event> osu::slider_events(const Beatmap& beatmap)
+{
+    std::vector<Slider_event> events;
+    slider_events(beatmap, events);
+    return events;
+}
+
+void osu::slider_events(const Beatmap& beatmap, std::vector<Slider_event>& events)
+{
+    events.clear();
+
+    const auto timing_index = Timing_index{beatmap.timingpoints};
+    auto cursor = timing_index.cursor();
+    std::vector<Vector2> points;
+    std::vector<float> distances;
+    for(std::size_t index = 0; index < beatmap.sliders.size(); ++index) {
+        const auto& slider = beatmap.sliders[index];
+        const auto timing = slider_timing(beatmap, slider, cursor);
+
+        // Reuse the parsed path if there is one
+        const auto has_path = !slider.points.empty() && slider.distances.size() == slider.points.size();
+        if(!has_path) {
+            sliderpath(slider, points);
+            distances = pathlengths(points);
+            fix_path_length(points, distances, slider.length);
+        }
+        const auto& path_points = has_path ? slider.points : points;
+        const auto& path_distances = has_path ? slider.distances : distances;
+
+        generate_events(slider, timing, [&](const Event_type type, const double time, const double distance) {
+            const auto pos = position_at_distance(path_points, path_distances, static_cast<float>(distance));
+            events.push_back({std::chrono::microseconds{std::llround(time)}, pos, static_cast<std::uint32_t>(index), type});
+        });
+    }
+
+    // Only overlapping sliders, which are rare, interleave their events
+    const auto by_time = [](const Slider_event& a, const Slider_event& b) { return a.time < b.time; };
+    if(!std::is_sorted(events.cbegin(), events.cend(), by_time)) std::stable_sort(events.begin(), events.end(), by_time);
+}
+
+std::size_t osu::max_combo(const Beatmap& beatmap)
+{
+    auto combo = beatmap.circles.size() + beatmap.spinners.size();
+
+    const auto timing_index = Timing_index{beatmap.timingpoints};
+    auto cursor = timing_index.cursor();
+    for(const auto& slider : beatmap.sliders) {
+        generate_events(slider, slider_timing(beatmap, slider, cursor), [&combo](Event_type, double, double) { ++combo; });
+    }
+    return combo;
+}
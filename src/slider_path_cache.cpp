@@ -0,0 +1,178 @@
+#include "osu_reader/slider_path_cache.h"
+#include "osu_reader/sliderpath.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+    class Hasher {
+    public:
+        void add(const std::uint32_t value)
+        {
+            hash_ = (hash_ ^ value) * 0x100000001B3ull;
+        }
+        void add(const float value)
+        {
+            std::uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            add(bits);
+        }
+
+        [[nodiscard]] std::uint64_t get() const { return hash_ ^ (hash_ >> 29); }
+
+    private:
+        std::uint64_t hash_ = 0xCBF29CE484222325ull;
+    };
+
+    std::uint64_t hash_key(const osu::Slider& slider, const osu::Path_quality& quality)
+    {
+        Hasher hasher;
+        hasher.add(slider.length);
+        hasher.add(quality.bezier_tolerance);
+        hasher.add(quality.arc_tolerance);
+        hasher.add(quality.catmull_tolerance);
+        hasher.add(quality.simplify_tolerance);
+        for(const auto& segment : slider.segments) {
+            hasher.add(static_cast<std::uint32_t>(segment.type));
+            hasher.add(static_cast<std::uint32_t>(segment.points.size()));
+            for(const auto& point : segment.points) {
+                hasher.add(point.x);
+                hasher.add(point.y);
+            }
+        }
+        return hasher.get();
+    }
+
+    bool same_quality(const osu::Path_quality& a, const osu::Path_quality& b)
+    {
+        return a.bezier_tolerance == b.bezier_tolerance && a.arc_tolerance == b.arc_tolerance &&
+               a.catmull_tolerance == b.catmull_tolerance && a.simplify_tolerance == b.simplify_tolerance;
+    }
+
+    bool same_segments(const std::vector<osu::Slider::Segment>& a, const std::vector<osu::Slider::Segment>& b)
+    {
+        return std::equal(a.cbegin(), a.cend(), b.cbegin(), b.cend(), [](const auto& l, const auto& r) {
+            return l.type == r.type && l.points == r.points;
+        });
+    }
+}// namespace
+
+struct osu::Slider_path_cache::Impl {
+    // Everything a path depends on is kept, so hash collisions can't return the wrong path
+    struct Entry {
+        std::uint64_t hash;
+        std::vector<Slider::Segment> segments;
+        float length;
+        Path_quality quality;
+        std::shared_ptr<const Path> path;
+        std::size_t bytes;
+    };
+    using Lru = std::list<Entry>;
+
+    const Entry* find(const std::uint64_t hash, const Slider& slider, const Path_quality& quality)
+    {
+        const auto [first, last] = index.equal_range(hash);
+        for(auto it = first; it != last; ++it) {
+            const auto& entry = *it->second;
+            if(entry.length == slider.length && same_quality(entry.quality, quality) && same_segments(entry.segments, slider.segments)) {
+                lru.splice(lru.begin(), lru, it->second);
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    void evict()
+    {
+        // The most recent entry is always kept, even if it alone exceeds the budget
+        while(bytes > memory_budget && lru.size() > 1) {
+            const auto& entry = lru.back();
+            const auto [first, last] = index.equal_range(entry.hash);
+            for(auto it = first; it != last; ++it) {
+                if(it->second == std::prev(lru.end())) {
+                    index.erase(it);
+                    break;
+                }
+            }
+            bytes -= entry.bytes;
+            lru.pop_back();
+            ++stats.evictions;
+        }
+    }
+
+    std::size_t memory_budget;
+    std::size_t bytes = 0;
+    Stats stats = {};
+    Lru lru;
+    std::unordered_multimap<std::uint64_t, Lru::iterator> index;
+    mutable std::mutex mutex;
+};
+
+osu::Slider_path_cache::Slider_path_cache(const std::size_t memory_budget) : impl_{std::make_unique<Impl>()}
+{
+    impl_->memory_budget = memory_budget;
+}
+
+osu::Slider_path_cache::~Slider_path_cache() = default;
+
+std::shared_ptr<const osu::Slider_path_cache::Path> osu::Slider_path_cache::get(const Slider& slider, const Path_quality& quality)
+{
+    const auto hash = hash_key(slider, quality);
+    {
+        const std::lock_guard lock{impl_->mutex};
+        if(const auto* entry = impl_->find(hash, slider, quality)) {
+            ++impl_->stats.hits;
+            return entry->path;
+        }
+        ++impl_->stats.misses;
+    }
+
+    // Computed without holding the lock, so other threads aren't held up. Two threads missing on the same slider
+    // both compute it, and the second one finds the path of the first when inserting.
+    auto path = std::make_shared<Path>();
+    path->deviation = sliderpath(slider, path->points, quality);
+    path->distances = pathlengths(path->points);
+    fix_path_length(path->points, path->distances, slider.length);
+
+    auto bytes = sizeof(Impl::Entry) + path->points.size() * sizeof(Vector2) + path->distances.size() * sizeof(float);
+    for(const auto& segment : slider.segments) bytes += sizeof(Slider::Segment) + segment.points.size() * sizeof(Vector2);
+
+    const std::lock_guard lock{impl_->mutex};
+    if(const auto* entry = impl_->find(hash, slider, quality)) return entry->path;
+
+    impl_->lru.push_front({hash, slider.segments, slider.length, quality, std::move(path), bytes});
+    impl_->index.emplace(hash, impl_->lru.begin());
+    impl_->bytes += bytes;
+    impl_->evict();
+    return impl_->lru.front().path;
+}
+
+float osu::Slider_path_cache::compute(Slider& slider, const Path_quality& quality)
+{
+    const auto path = get(slider, quality);
+    slider.points = path->points;
+    slider.distances = path->distances;
+    return path->deviation;
+}
+
+osu::Slider_path_cache::Stats osu::Slider_path_cache::stats() const
+{
+    const std::lock_guard lock{impl_->mutex};
+    auto stats = impl_->stats;
+    stats.entries = impl_->lru.size();
+    stats.bytes = impl_->bytes;
+    return stats;
+}
+
+void osu::Slider_path_cache::clear()
+{
+    const std::lock_guard lock{impl_->mutex};
+    impl_->index.clear();
+    impl_->lru.clear();
+    impl_->bytes = 0;
+    impl_->stats = {};
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "osu_reader/beatmap_parser.h"
+#include "scan.h"
+#include <algorithm>
+#include <cctype>
+
+namespace osu {
+    /// Whether text in front of a '[' still allows it to start a section header.
+    /// Zero bytes are accepted so that utf16 files are recognised too.
+    inline bool is_section_padding(const std::string_view prefix)
+    {
+        return std::all_of(prefix.cbegin(), prefix.cend(), [](const char c) {
+            return c == '\0' || std::isspace(static_cast<unsigned char>(c)) != 0;
+        });
+    }
+}// namespace osu
+
+class osu::Beatmap_parser::String_line_provider : public Line_provider {
+public:
+    explicit String_line_provider(std::string_view content) : content{content} {}
+    inline std::optional<std::string_view> get_line() override
+    {
+        if(last_pos == std::string_view::npos || last_pos >= content.size()) return std::nullopt;
+
+        const auto start_pos = last_pos;
+
+        const auto pos = scan::find(content, '\n', last_pos);
+        last_pos = (pos == std::string_view::npos) ? content.size() : pos + 1;
+
+        return content.substr(start_pos, last_pos - start_pos);
+    }
+
+    std::optional<std::string_view> skip_to_section() override
+    {
+        for(auto pos = last_pos; pos < content.size();) {
+            const auto bracket = scan::find(content, '[', pos);
+            if(bracket == std::string_view::npos) break;
+            pos = bracket + 1;
+
+            const auto newline = content.rfind('\n', bracket);
+            const auto line_start = newline == std::string_view::npos ? 0 : newline + 1;
+            if(is_section_padding(content.substr(line_start, bracket - line_start))) {
+                last_pos = line_start;
+                return get_line();
+            }
+        }
+        last_pos = content.size();
+        return std::nullopt;
+    }
+
+    /// Offset of the next line in content
+    [[nodiscard]] std::size_t position() const { return last_pos; }
+
+private:
+    std::string_view content;
+    std::size_t last_pos = 0;
+};
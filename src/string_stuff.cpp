@@ -1,23 +1,61 @@
 #include "osu_reader/string_stuff.h"
+#include "scan.h"
+#include <array>
 
-std::vector<std::string_view> osu::split(const std::string_view s, const char delim)
+// Calls add_token for every non-empty token of s
+template<typename Callback>
+static void for_each_token(const std::string_view s, const char delim, Callback add_token)
 {
-    std::vector<std::string_view> ret;
-    const auto* it = s.begin();
-    const auto* it_start = s.begin();
+    // Delimiters are located in bulk, one batch of positions at a time
+    std::array<std::uint32_t, 64> positions{};
+    std::size_t token_start = 0;
+    std::size_t offset = 0;
 
-    const auto add_if_not_zero = [&] {
-        if(it != it_start) {
-            ret.emplace_back(s.data() + (it_start - s.begin()), it - it_start);
+    const auto add_if_not_zero = [&](const std::size_t token_end) {
+        if(token_end != token_start) {
+            add_token(std::string_view{s.data() + token_start, token_end - token_start});
         }
     };
 
-    for(; it != s.end(); ++it) {
-        if(*it == delim) {
-            add_if_not_zero();
-            it_start = it + 1;
+    while(offset < s.size()) {
+        const auto count = osu::scan::find_all(s.substr(offset), delim, positions.data(), positions.size());
+        for(std::size_t i = 0; i < count; ++i) {
+            const auto pos = offset + positions[i];
+            add_if_not_zero(pos);
+            token_start = pos + 1;
         }
+        if(count < positions.size()) break;
+        offset += positions.back() + 1;
     }
-    add_if_not_zero();
+    add_if_not_zero(s.size());
+}
+
+std::vector<std::string_view> osu::split(const std::string_view s, const char delim)
+{
+    std::vector<std::string_view> ret;
+    for_each_token(s, delim, [&ret](const std::string_view token) {
+        ret.push_back(token);
+    });
     return ret;
 }
+
+std::size_t osu::split(const std::string_view s, const char delim, std::string_view* const tokens, const std::size_t capacity)
+{
+    std::size_t count = 0;
+    for_each_token(s, delim, [&](const std::string_view token) {
+        if(count < capacity) tokens[count] = token;
+        ++count;
+    });
+    return count;
+}
+
+std::optional<std::string_view> osu::Tokenizer::next()
+{
+    while(pos_ < s_.size()) {
+        const auto start = pos_;
+        const auto end = std::min(scan::find(s_, delim_, pos_), s_.size());
+        pos_ = end + 1;
+        if(end != start) return s_.substr(start, end - start);
+    }
+    return std::nullopt;
+}
@@ -0,0 +1,97 @@
+#include "thread_pool.h"
+#include <algorithm>
+
+static thread_local std::size_t worker_index = 0;
+
+osu::Thread_pool::Thread_pool(std::size_t threads)
+{
+    if(threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    queues_.reserve(threads);
+    for(std::size_t i = 0; i < threads; ++i) queues_.push_back(std::make_unique<Queue>());
+
+    threads_.reserve(threads);
+    for(std::size_t i = 0; i < threads; ++i) threads_.emplace_back([this, i] { run_worker(i); });
+}
+
+osu::Thread_pool::~Thread_pool()
+{
+    wait();
+    {
+        const std::lock_guard lock{mutex_};
+        stopping_ = true;
+    }
+    work_available_.notify_all();
+    for(auto& thread : threads_) thread.join();
+}
+
+void osu::Thread_pool::submit(std::function<void()> task)
+{
+    // Spread tasks over the queues; workers that run out steal from the others
+    auto& queue = *queues_[next_queue_++ % queues_.size()];
+    {
+        const std::lock_guard queue_lock{queue.mutex};
+        queue.tasks.push_back(std::move(task));
+    }
+    {
+        const std::lock_guard lock{mutex_};
+        ++queued_;
+        ++unfinished_;
+    }
+    work_available_.notify_one();
+}
+
+void osu::Thread_pool::wait()
+{
+    std::unique_lock lock{mutex_};
+    all_done_.wait(lock, [this] { return unfinished_ == 0; });
+}
+
+std::size_t osu::Thread_pool::current_worker()
+{
+    return worker_index;
+}
+
+bool osu::Thread_pool::try_pop(const std::size_t index, std::function<void()>& task)
+{
+    // Own queue from the back for locality, others from the front
+    for(std::size_t offset = 0; offset < queues_.size(); ++offset) {
+        auto& queue = *queues_[(index + offset) % queues_.size()];
+        const std::lock_guard queue_lock{queue.mutex};
+        if(queue.tasks.empty()) continue;
+
+        if(offset == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        return true;
+    }
+    return false;
+}
+
+void osu::Thread_pool::run_worker(const std::size_t index)
+{
+    worker_index = index;
+
+    std::function<void()> task;
+    while(true) {
+        {
+            std::unique_lock lock{mutex_};
+            work_available_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+            if(queued_ == 0) return;// Stopping and nothing left to do
+            --queued_;
+        }
+
+        // A task was reserved above, so one of the queues is guaranteed to hold one
+        while(!try_pop(index, task)) std::this_thread::yield();
+
+        task();
+        task = nullptr;
+
+        const std::lock_guard lock{mutex_};
+        if(--unfinished_ == 0) all_done_.notify_all();
+    }
+}
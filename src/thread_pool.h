@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace osu {
+    /// Work stealing thread pool. Every worker owns a task queue; idle workers take tasks from the others.
+    /// Tasks must not throw.
+    class Thread_pool {
+    public:
+        /// Starts threads workers, or one per hardware thread if threads is 0
+        explicit Thread_pool(std::size_t threads = 0);
+        Thread_pool(const Thread_pool&) = delete;
+        Thread_pool& operator=(const Thread_pool&) = delete;
+        /// Finishes all submitted tasks, then joins the workers
+        ~Thread_pool();
+
+        void submit(std::function<void()> task);
+        /// Blocks until every submitted task has finished
+        void wait();
+
+        /// Calls function(begin, end) for consecutive chunks of at most chunk_size indices covering [0, count),
+        /// then waits for the whole pool to finish
+        template<typename Function>
+        void parallel_for(std::size_t count, std::size_t chunk_size, const Function& function);
+
+        [[nodiscard]] std::size_t size() const { return threads_.size(); }
+        /// Index of the worker running the calling thread in [0, size()), only valid inside tasks
+        [[nodiscard]] static std::size_t current_worker();
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        void run_worker(std::size_t index);
+        bool try_pop(std::size_t index, std::function<void()>& task);
+
+        std::vector<std::unique_ptr<Queue>> queues_;
+        std::vector<std::thread> threads_;
+
+        std::mutex mutex_;
+        std::condition_variable work_available_;
+        std::condition_variable all_done_;
+        std::size_t queued_ = 0;
+        std::size_t unfinished_ = 0;
+        bool stopping_ = false;
+
+        std::atomic<std::size_t> next_queue_{0};
+    };
+
+    template<typename Function>
+    void Thread_pool::parallel_for(const std::size_t count, const std::size_t chunk_size, const Function& function)
+    {
+        for(std::size_t begin = 0; begin < count; begin += chunk_size) {
+            const auto end = std::min(count, begin + chunk_size);
+            submit([&function, begin, end] { function(begin, end); });
+        }
+        wait();
+    }
+}// namespace osu
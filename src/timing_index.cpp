@@ -0,0 +1,108 @@
+#include "osu_reader/timing_index.h"
+#include <algorithm>
+
+namespace {
+    template<typename Point>
+    bool after(const std::chrono::milliseconds time, const Point& point)
+    {
+        return time < point.time;
+    }
+
+    // Index of the last point at or before time, 0 if there is none. Gallops forward from hint,
+    // so sorted queries are constant time amortised, and searches the front of the track for earlier times.
+    template<typename Point>
+    std::size_t find_point(const std::vector<Point>& track, const std::chrono::milliseconds time, const std::size_t hint)
+    {
+        const auto first = track.cbegin();
+        auto low = std::min(hint, track.size() - 1);
+        if(time < track[low].time) {
+            const auto it = std::upper_bound(first, first + static_cast<std::ptrdiff_t>(low), time, after<Point>);
+            return it == first ? 0 : static_cast<std::size_t>(it - first) - 1;
+        }
+
+        auto high = low + 1;
+        std::size_t step = 1;
+        while(high < track.size() && track[high].time <= time) {
+            low = high;
+            high = std::min(high + step, track.size());
+            step *= 2;
+        }
+        // track[low] is at or before time, track[high] after it
+        const auto it = std::upper_bound(first + static_cast<std::ptrdiff_t>(low) + 1, first + static_cast<std::ptrdiff_t>(high),
+                                         time, after<Point>);
+        return static_cast<std::size_t>(it - first) - 1;
+    }
+}// namespace
+
+osu::Timing_index::Timing_index(const std::vector<Beatmap::Timingpoint>& timingpoints)
+{
+    const auto by_time = [](const Beatmap::Timingpoint& a, const Beatmap::Timingpoint& b) { return a.time < b.time; };
+
+    // Files are nearly always sorted already
+    std::vector<Beatmap::Timingpoint> sorted;
+    const auto* points = &timingpoints;
+    if(!std::is_sorted(timingpoints.cbegin(), timingpoints.cend(), by_time)) {
+        sorted = timingpoints;
+        std::stable_sort(sorted.begin(), sorted.end(), by_time);
+        points = &sorted;
+    }
+
+    effects_.reserve(points->size());
+    for(const auto& point : *points) {
+        if(point.uninherited) timings_.push_back({point.time, point.beat_duration, point.meter});
+    }
+
+    // Inherited points before the first uninherited one are relative to it
+    std::size_t timing = 0;
+    for(const auto& point : *points) {
+        while(timing + 1 < timings_.size() && timings_[timing + 1].time <= point.time) ++timing;
+
+        auto velocity = 1.f;
+        if(!point.uninherited && !timings_.empty() && point.beat_duration.count() > 0) {
+            velocity = static_cast<float>(static_cast<double>(timings_[timing].beat_duration.count()) /
+                                          static_cast<double>(point.beat_duration.count()));
+        }
+        effects_.push_back({point.time, point.beat_duration, velocity, point.sample_set, point.sample_index,
+                            point.sample_volume, point.kiai});
+    }
+}
+
+osu::Timing_index::State osu::Timing_index::at(const std::chrono::milliseconds time) const
+{
+    if(empty()) return state(0, 0);
+    const auto timing = timings_.empty() ? 0 : find_point(timings_, time, 0);
+    return state(timing, find_point(effects_, time, 0));
+}
+
+osu::Timing_index::State osu::Timing_index::Cursor::seek(const std::chrono::milliseconds time)
+{
+    if(index_->empty()) return index_->state(0, 0);
+    if(!index_->timings_.empty()) timing_ = find_point(index_->timings_, time, timing_);
+    effect_ = find_point(index_->effects_, time, effect_);
+    return index_->state(timing_, effect_);
+}
+
+osu::Timing_index::State osu::Timing_index::state(const std::size_t timing, const std::size_t effect) const
+{
+    State state{};
+    state.slider_velocity = 1;
+    if(!timings_.empty()) {
+        state.beat_duration = timings_[timing].beat_duration;
+        state.meter = timings_[timing].meter;
+    }
+    if(!effects_.empty()) {
+        const auto& point = effects_[effect];
+        state.effective_beat_duration = point.effective_beat_duration;
+        state.slider_velocity = point.slider_velocity;
+        state.sample_set = point.sample_set;
+        state.sample_index = point.sample_index;
+        state.sample_volume = point.sample_volume;
+        state.kiai = point.kiai;
+    }
+    return state;
+}
+
+void osu::compute_slider_durations(Beatmap& beatmap)
+{
+    compute_slider_durations(beatmap.sliders, Timing_index{beatmap.timingpoints}, beatmap.slider_multiplier);
+}
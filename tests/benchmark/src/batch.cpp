@@ -0,0 +1,29 @@
+#include "benchmark.h"
+#include <osu_reader/batch_parser.h>
+#include <algorithm>
+#include <thread>
+
+void batch_benchmarks()
+{
+    // Songs folder stand-in made of copies of the test maps
+    const auto directory = std::filesystem::temp_directory_path() / "osu_reader_batch_benchmark";
+    std::filesystem::create_directories(directory);
+    for(const auto& entry : std::filesystem::directory_iterator{OSU_READER_RES_DIR}) {
+        if(entry.path().extension() != ".osu") continue;
+        for(auto i = 0; i < 50; ++i) {
+            const auto target = directory / (std::to_string(i) + " " + entry.path().filename().string());
+            std::filesystem::copy_file(entry.path(), target, std::filesystem::copy_options::overwrite_existing);
+        }
+    }
+
+    const auto run = [&](const std::size_t threads) {
+        return [&directory, threads] {
+            return osu::parse_directory(directory, osu::Batch_options{threads}, [](const auto&, const auto&) {}).value();
+        };
+    };
+
+    benchmark("parse directory, 1 thread", "files", run(1));
+    benchmark("parse directory, all hardware threads", "files", run(std::max(1u, std::thread::hardware_concurrency())));
+
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,104 @@
+#include "benchmark.h"
+#include <algorithm>
+#include <string>
+#include <type_traits>
+#include <osu_reader/beat_snap.h>
+#include <osu_reader/beatmap_parser.h>
+#include <osu_reader/lazy_beatmap.h>
+#include <osu_reader/slider_events.h>
+
+static std::size_t object_count(const osu::Beatmap& bm)
+{
+    return bm.circles.size() + bm.sliders.size() + bm.spinners.size();
+}
+
+void beatmap_benchmarks()
+{
+    const auto content = resource_string(
+            "Buta-Otome - Kakoi-naki Yo wa Ichigo no Tsukikage (BarkingMadDog) [this map is so bad cuz overmapping].osu");
+
+    // Everything up to [Events], the sections a metadata scan is made of
+    const auto header_content = content.substr(0, content.find("[Events]"));
+    const auto header_lines = static_cast<std::size_t>(std::count(header_content.cbegin(), header_content.cend(), '\n'));
+
+    auto parser = osu::Beatmap_parser{};
+    benchmark("parse header sections", "lines", [&] {
+        return parser.from_string(header_content).value().version > 0 ? header_lines : 0;
+    });
+
+    auto metadata_parser = osu::Beatmap_parser{};
+    metadata_parser.sections = osu::Beatmap_section::general | osu::Beatmap_section::metadata;
+    benchmark("parse with section mask", "files", [&] {
+        return metadata_parser.from_string(content).value().title.empty() ? 0 : 1;
+    });
+
+    benchmark("lazy beatmap metadata", "files", [&] {
+        auto lazy = osu::Lazy_beatmap::from_string(content);
+        return lazy->get(osu::Beatmap_section::metadata).title.empty() ? 0 : 1;
+    });
+
+    benchmark("parse beatmap", "objects", [&] {
+        return object_count(parser.from_string(content).value());
+    });
+
+    benchmark("stream beatmap", "objects", [&] {
+        std::size_t objects = 0;
+        parser.stream_string(content, [&](const auto& object) {
+            if constexpr(!std::is_same_v<std::decay_t<decltype(object)>, osu::Beatmap::Timingpoint>) ++objects;
+        });
+        return objects;
+    });
+
+    auto path_parser = osu::Beatmap_parser{};
+    path_parser.slider_paths = true;
+    benchmark("parse beatmap with slider paths", "objects", [&] {
+        return object_count(path_parser.from_string(content).value());
+    });
+
+    for(const auto& [name, quality] : {std::pair{"parse beatmap with preview slider paths", osu::Path_quality::preview()},
+                                       std::pair{"parse beatmap with thumbnail slider paths", osu::Path_quality::thumbnail()}}) {
+        auto quality_parser = osu::Beatmap_parser{};
+        quality_parser.slider_paths = true;
+        quality_parser.path_quality = quality;
+        benchmark(name, "objects", [&] {
+            return object_count(quality_parser.from_string(content).value());
+        });
+    }
+
+    auto parallel_path_parser = osu::Beatmap_parser{};
+    parallel_path_parser.slider_paths = true;
+    parallel_path_parser.path_threads = 0;
+    benchmark("parse beatmap with parallel slider paths", "objects", [&] {
+        return object_count(parallel_path_parser.from_string(content).value());
+    });
+
+    benchmark("parse arena beatmap with slider paths", "objects", [&] {
+        const auto arena = path_parser.arena_from_string(content).value();
+        return arena.circles.size() + arena.sliders.size() + arena.spinners.size();
+    });
+
+    const auto path_beatmap = path_parser.from_string(content).value();
+    std::vector<osu::Slider_event> events;
+    benchmark("slider events", "events", [&] {
+        osu::slider_events(path_beatmap, events);
+        return events.size();
+    });
+    benchmark("max combo", "sliders", [&] {
+        return osu::max_combo(path_beatmap) > 0 ? path_beatmap.sliders.size() : 0;
+    });
+    std::vector<osu::Beat_snap> snaps;
+    benchmark("beat snaps", "snaps", [&] {
+        osu::beat_snaps(path_beatmap, snaps);
+        return snaps.size();
+    });
+
+    // One BPM and a slider velocity change before every slider, like modern SV heavy maps
+    std::string sv_content = "osu file format v14\n\n[Difficulty]\nSliderMultiplier:1.4\n\n[TimingPoints]\n0,400,4,2,0,60,1,0\n";
+    constexpr auto sv_changes = 20000;
+    for(auto i = 0; i < sv_changes; ++i) sv_content += std::to_string(i * 100 + 50) + ",-" + std::to_string(50 + i % 100) + ",4,2,0,60,0,0\n";
+    sv_content += "\n[HitObjects]\n";
+    for(auto i = 0; i < sv_changes; ++i) sv_content += "64,64," + std::to_string(i * 100 + 60) + ",2,0,L|128:64,1,64\n";
+    benchmark("parse SV heavy beatmap", "timing points", [&] {
+        return parser.from_string(sv_content).value().timingpoints.size();
+    });
+}
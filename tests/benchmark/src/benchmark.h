@@ -0,0 +1,53 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+/// Only benchmarks whose name contains this are run, set from the first command line argument
+inline std::string_view benchmark_filter;
+
+inline std::string resource_string(const char* filename)
+{
+    std::ifstream f(std::string{OSU_READER_RES_DIR} + filename, std::ios::binary);
+    return {(std::istreambuf_iterator<char>(f)),
+            std::istreambuf_iterator<char>()};
+}
+
+/// Repeatedly calls run, which returns the number of items it processed, and prints the throughput.
+/// The fastest of several batches is reported, which is far less sensitive to noise than the mean.
+template<typename Fn>
+void benchmark(const char* name, const char* unit, Fn run)
+{
+    if(std::string_view{name}.find(benchmark_filter) == std::string_view::npos) return;
+
+    using Clock = std::chrono::steady_clock;
+    constexpr auto batches = 10;
+    constexpr auto batch_target = std::chrono::milliseconds{100};
+
+    run();// Warm up caches
+
+    auto best_rate = 0.;
+    auto best_iteration_time = 0.;
+    for(auto batch = 0; batch < batches; ++batch) {
+        std::size_t items = 0;
+        std::size_t iterations = 0;
+        const auto start = Clock::now();
+        auto elapsed = Clock::duration{};
+        do {
+            items += run();
+            ++iterations;
+            elapsed = Clock::now() - start;
+        } while(elapsed < batch_target);
+
+        const auto seconds = std::chrono::duration<double>(elapsed).count();
+        if(const auto rate = static_cast<double>(items) / seconds; rate > best_rate) {
+            best_rate = rate;
+            best_iteration_time = seconds * 1e6 / static_cast<double>(iterations);
+        }
+    }
+
+    std::printf("%-40s %14.0f %s/s %12.3f us/iteration\n", name, best_rate, unit, best_iteration_time);
+}
@@ -0,0 +1,16 @@
+#include "benchmark.h"
+
+void beatmap_benchmarks();
+void replay_benchmarks();
+void batch_benchmarks();
+void sliderpath_benchmarks();
+
+int main(int argc, char** argv)
+{
+    if(argc > 1) benchmark_filter = argv[1];
+
+    beatmap_benchmarks();
+    sliderpath_benchmarks();
+    replay_benchmarks();
+    batch_benchmarks();
+}
@@ -0,0 +1,13 @@
+#include "benchmark.h"
+#include <osu_reader/replay_reader.h>
+
+void replay_benchmarks()
+{
+    const auto content = resource_string("cptnXn - xi - FREEDOM DiVE [FOUR DIMENSIONS] (2014-05-11) Osu.osr");
+
+    auto reader = osu::Replay_reader{};
+    reader.parse_frames = true;
+    benchmark("parse replay frames", "frames", [&] {
+        return reader.from_string(content).value().frames.value().size();
+    });
+}
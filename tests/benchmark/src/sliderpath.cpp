@@ -0,0 +1,90 @@
+#include "benchmark.h"
+#include <hitobject/parse_hitobject.h>
+#include <osu_reader/slider_position.h>
+#include <osu_reader/sliderpath.h>
+
+void sliderpath_benchmarks()
+{
+    // Long bezier slider with many control points, from the slider tests
+    const auto bezier_string = "256,192,74363,118,0,B|208:4|8:8|8:8|40:36|48:63|48:63|44:104|44:104|92:128|76:188|76:188|112:204|152:192|152:192|56:248|32:360|32:360|64:332|100:332|100:332|152:348|196:320|196:320|216:280|256:276|256:276|261:255|261:255|254:246|254:246|259:238|259:238|251:236|251:236|263:225|263:225|253:214|253:214|262:205|262:205|256:201|256:201|256:160,1,1200.0479469394";
+    const auto bezier = parse_slider(osu::split(bezier_string, ',')).value();
+
+    // A single segment with many control points is the worst case for subdivision
+    const auto smooth_string = "0,0,0,2,0,B|40:200|120:-150|200:260|280:-90|360:300|440:-20|520:180|600:40|680:240|760:0,1,2000";
+    const auto smooth = parse_slider(osu::split(smooth_string, ',')).value();
+
+    // Control points of a long wave, as found in hand drawn marathon sliders
+    const auto long_string = "0,192,0,2,0,B|20:309|40:338|60:256|80:125|100:45|120:76|140:194|160:311|180:337|200:253|220:123|240:44|260:77|280:197|300:312|320:336|340:251|360:121|380:44|400:79|420:199|440:314|460:336|480:249|500:118|520:43|540:81|560:202|580:315|600:335|620:246,1,3000";
+    const auto long_curve = parse_slider(osu::split(long_string, ',')).value();
+
+    // Long catmull slider with sharp turns, as found in old maps
+    const auto catmull_string = "0,192,0,2,0,C|20:309|40:338|60:256|80:125|100:45|120:76|140:194|160:311|180:337|200:253|220:123|240:44|260:77|280:197|300:312|320:336|340:251|360:121|380:44|400:79|420:199|440:314|460:336|480:249|500:118|520:43|540:81|560:202|580:315|600:335,1,3000";
+    const auto catmull = parse_slider(osu::split(catmull_string, ',')).value();
+
+    // Wide arc, the most common slider type in modern maps
+    const auto perfect_string = "64,320,0,2,0,P|256:40|448:320,1,700";
+    const auto perfect = parse_slider(osu::split(perfect_string, ',')).value();
+
+    benchmark("sliderpath bezier, many segments", "sliders", [&] {
+        return osu::sliderpath(bezier).empty() ? 0 : 1;
+    });
+    benchmark("sliderpath bezier, 11 control points", "sliders", [&] {
+        return osu::sliderpath(smooth).empty() ? 0 : 1;
+    });
+    benchmark("sliderpath bezier, 32 control points", "sliders", [&] {
+        return osu::sliderpath(long_curve).empty() ? 0 : 1;
+    });
+    std::vector<osu::Vector2> path;
+    benchmark("sliderpath bezier, many segments, preview quality", "sliders", [&] {
+        osu::sliderpath(bezier, path, osu::Path_quality::preview());
+        return path.empty() ? 0 : 1;
+    });
+    benchmark("sliderpath bezier, many segments, thumbnail quality", "sliders", [&] {
+        osu::sliderpath(bezier, path, osu::Path_quality::thumbnail());
+        return path.empty() ? 0 : 1;
+    });
+    benchmark("sliderpath perfect circle", "sliders", [&] {
+        return osu::sliderpath(perfect).empty() ? 0 : 1;
+    });
+    benchmark("sliderpath catmull, 30 control points", "sliders", [&] {
+        return osu::sliderpath(catmull).empty() ? 0 : 1;
+    });
+
+    // One query per millisecond over the whole slider, like judging a replay
+    auto judged = bezier;
+    osu::compute_slider_path(judged);
+    judged.repeat = 2;
+    judged.duration = std::chrono::milliseconds{1000};
+    std::vector<std::chrono::milliseconds> times;
+    for(auto t = judged.time; t <= judged.time + judged.repeat * judged.duration; ++t) times.push_back(t);
+    std::vector<osu::Vector2> positions;
+
+    benchmark("slider positions, single queries", "queries", [&] {
+        positions.clear();
+        for(const auto time : times) positions.push_back(osu::position_at_time(judged, time));
+        return positions.size();
+    });
+    benchmark("slider positions, batched", "queries", [&] {
+        osu::positions_at_times(judged, times, positions);
+        return positions.size();
+    });
+
+    // Scattered lookups, like sampling features from random points of a slider
+    std::vector<float> fractions;
+    for(std::size_t i = 0; i < 1000; ++i) fractions.push_back(static_cast<float>(i * 7919 % 1000) / 1000);
+    const auto table = osu::Arc_length_table{judged};
+    benchmark("slider positions, scattered queries", "queries", [&] {
+        positions.clear();
+        for(const auto f : fractions) positions.push_back(osu::position_at_progress(judged, f));
+        return positions.size();
+    });
+    benchmark("slider positions, scattered, arc length table", "queries", [&] {
+        positions.clear();
+        for(const auto f : fractions) positions.push_back(osu::position_at_progress(judged, table, f));
+        return positions.size();
+    });
+    benchmark("slider path resampled to 256 points", "points", [&] {
+        osu::resample_path(judged.points, judged.distances, 256, positions);
+        return positions.size();
+    });
+}
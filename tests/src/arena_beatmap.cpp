@@ -0,0 +1,53 @@
+#include "file_string.h"
+#include <catch2/catch.hpp>
+#include <osu_reader/beatmap_parser.h>
+
+TEST_CASE("Arena beatmap")
+{
+    static constexpr const char* filename = "res/Buta-Otome - Kakoi-naki Yo wa Ichigo no Tsukikage (BarkingMadDog) [this map is so bad cuz overmapping].osu";
+
+    auto parser = osu::Beatmap_parser{};
+    parser.slider_paths = true;
+    const auto full = parser.from_file(filename);
+    REQUIRE(full);
+
+    const auto from_file = GENERATE(true, false);
+    auto parsed = from_file ? parser.arena_from_file(filename) : parser.arena_from_string(file_string(filename));
+    REQUIRE(parsed);
+
+    // Moving keeps the arena alive
+    const auto arena = std::move(*parsed);
+    parsed.reset();
+
+    CHECK(arena.header.title == full->title);
+    CHECK(arena.header.timingpoints.size() == full->timingpoints.size());
+    CHECK(arena.header.sliders.empty());
+
+    REQUIRE(arena.circles.size() == full->circles.size());
+    REQUIRE(arena.spinners.size() == full->spinners.size());
+    REQUIRE(arena.sliders.size() == full->sliders.size());
+    for(std::size_t i = 0; i < arena.sliders.size(); ++i) {
+        const auto& slider = arena.sliders[i];
+        const auto& expected = full->sliders[i];
+        CHECK(slider.time == expected.time);
+        CHECK(slider.duration == expected.duration);
+        CHECK(slider.type == expected.type);
+        CHECK(slider.repeat == expected.repeat);
+        CHECK(slider.length == expected.length);
+        CHECK(std::equal(slider.points.cbegin(), slider.points.cend(), expected.points.cbegin(), expected.points.cend()));
+        CHECK(std::equal(slider.distances.cbegin(), slider.distances.cend(), expected.distances.cbegin(), expected.distances.cend()));
+        REQUIRE(slider.segments.size() == expected.segments.size());
+        for(std::size_t j = 0; j < slider.segments.size(); ++j) {
+            CHECK(slider.segments[j].type == expected.segments[j].type);
+            CHECK(std::equal(slider.segments[j].points.cbegin(), slider.segments[j].points.cend(),
+                             expected.segments[j].points.cbegin(), expected.segments[j].points.cend()));
+            CHECK(slider.segments[j].points.get_allocator() == arena.sliders.get_allocator());
+        }
+    }
+}
+
+TEST_CASE("Arena beatmap missing")
+{
+    auto parser = osu::Beatmap_parser{};
+    CHECK(!parser.arena_from_file("res/not a file.osu"));
+}
@@ -0,0 +1,55 @@
+#include <catch2/catch.hpp>
+#include <map>
+#include <osu_reader/batch_parser.h>
+#include <osu_reader/beatmap_parser.h>
+#include <stdexcept>
+
+TEST_CASE("Parse directory")
+{
+    const auto threads = GENERATE(1, 4);
+
+    // Catch assertions aren't thread safe, so results are only collected in the callback
+    std::map<std::filesystem::path, std::optional<std::size_t>> object_counts;
+    const auto count = osu::parse_directory("res", osu::Batch_options{static_cast<std::size_t>(threads)},
+                                            [&](const std::filesystem::path& file_path, std::optional<osu::Beatmap> bm) {
+                                                if(bm) object_counts[file_path] = bm->circles.size() + bm->sliders.size() + bm->spinners.size();
+                                                else
+                                                    object_counts[file_path] = std::nullopt;
+                                            });
+
+    REQUIRE(count);
+    CHECK(*count == 5);
+    CHECK(object_counts.size() == 5);
+
+    // Same results as parsing on a single thread
+    auto parser = osu::Beatmap_parser{};
+    for(const auto& [file_path, objects] : object_counts) {
+        const auto bm = parser.from_file(file_path);
+        REQUIRE(bm);
+        REQUIRE(objects);
+        CHECK(bm->circles.size() + bm->sliders.size() + bm->spinners.size() == *objects);
+    }
+}
+
+TEST_CASE("Parse missing directory")
+{
+    auto calls = 0;
+    const auto count = osu::parse_directory("res/not a directory", {}, [&](const auto&, const auto&) {
+        ++calls;
+    });
+
+    CHECK(!count);
+    CHECK(calls == 0);
+}
+
+TEST_CASE("Parse directory with throwing callback")
+{
+    auto calls = 0;
+    CHECK_THROWS_AS(osu::parse_directory("res", osu::Batch_options{2},
+                                         [&](const std::filesystem::path&, std::optional<osu::Beatmap>) {
+                                             ++calls;
+                                             throw std::runtime_error{"callback failed"};
+                                         }),
+                    std::runtime_error);
+    CHECK(calls == 1);
+}
@@ -0,0 +1,76 @@
+#include <catch2/catch.hpp>
+#include <osu_reader/beat_snap.h>
+#include <osu_reader/beatmap_parser.h>
+
+namespace {
+    constexpr const char* filename = "res/Buta-Otome - Kakoi-naki Yo wa Ichigo no Tsukikage (BarkingMadDog) [this map is so bad cuz overmapping].osu";
+}
+
+TEST_CASE("Beat snap divisors")
+{
+    using namespace std::chrono_literals;
+
+    // 120 BPM from 1000ms, so a beat is 500ms, then 100 BPM from 10000ms
+    auto beatmap = osu::Beatmap{};
+    beatmap.slider_multiplier = 1;
+    beatmap.timingpoints = {{1000ms, 500000us, 4, 0, 0, 100, true, false},
+                            {3000ms, 250000us, 4, 0, 0, 100, false, false},
+                            {10000ms, 600000us, 4, 0, 0, 100, true, false}};
+    beatmap.circles = {{{0, 0}, 1500ms}, {{0, 0}, 1250ms}, {{0, 0}, 1166ms}, {{0, 0}, 1062ms}, {{0, 0}, 1010ms},
+                       {{0, 0}, 10200ms}, {{0, 0}, 500ms}};
+    beatmap.spinners = {{2000ms, 2333ms}};
+    // Doubled slider velocity, 100 pixels take half a beat
+    auto slider = osu::Slider{};
+    slider.time = 3000ms;
+    slider.length = 100;
+    slider.repeat = 1;
+    beatmap.sliders = {slider};
+
+    const auto snaps = osu::beat_snaps(beatmap);
+    REQUIRE(snaps.size() == 11);
+    CHECK(std::is_sorted(snaps.cbegin(), snaps.cend(), [](const auto& a, const auto& b) { return a.time < b.time; }));
+
+    const auto find = [&](const osu::Beat_snap::Kind kind, const std::uint32_t object) {
+        return *std::find_if(snaps.cbegin(), snaps.cend(), [&](const auto& s) { return s.kind == kind && s.object == object; });
+    };
+    using Kind = osu::Beat_snap::Kind;
+    CHECK(find(Kind::circle, 0).divisor == 1);
+    CHECK(find(Kind::circle, 1).divisor == 2);
+    CHECK(find(Kind::circle, 2).divisor == 3);// 1166.67ms
+    CHECK(find(Kind::circle, 2).error == Approx(-0.667f).margin(1e-3));
+    CHECK(find(Kind::circle, 3).divisor == 8);// 1062.5ms
+    CHECK(find(Kind::circle, 4).divisor == 0);// 10ms after the beat, 21.25ms before the next 1/16
+    CHECK(find(Kind::circle, 4).error == Approx(10).margin(1e-3));
+    CHECK(find(Kind::circle, 5).divisor == 3);// Second timing point
+    CHECK(find(Kind::circle, 6).divisor == 1);// Before the first timing point
+    CHECK(find(Kind::spinner_start, 0).divisor == 1);
+    CHECK(find(Kind::spinner_end, 0).divisor == 3);
+    CHECK(find(Kind::slider_head, 0).divisor == 1);
+    CHECK(find(Kind::slider_tail, 0).time == 3250000us);
+    CHECK(find(Kind::slider_tail, 0).divisor == 2);
+
+    auto coarse = osu::Beat_snap_options{};
+    coarse.max_divisor = 4;
+    CHECK(osu::beat_snaps(beatmap, coarse)[2].divisor == 0);// The 1/8 circle
+
+    beatmap.timingpoints.clear();
+    for(const auto& snap : osu::beat_snaps(beatmap)) CHECK(snap.divisor == 0);
+}
+
+TEST_CASE("Beat snaps of a ranked map")
+{
+    auto parser = osu::Beatmap_parser{};
+    const auto beatmap = parser.from_file(filename);
+    REQUIRE(beatmap);
+
+    std::vector<osu::Beat_snap> snaps;
+    osu::beat_snaps(*beatmap, snaps);
+    REQUIRE(snaps.size() == beatmap->circles.size() + 2 * (beatmap->sliders.size() + beatmap->spinners.size()));
+
+    // Objects of a ranked map are snapped, apart from very few rounding outliers
+    const auto snapped = std::count_if(snaps.cbegin(), snaps.cend(), [](const auto& s) { return s.divisor != 0; });
+    CHECK(static_cast<double>(snapped) / static_cast<double>(snaps.size()) > 0.95);
+    for(const auto& snap : snaps) {
+        if(snap.divisor != 0) CHECK(std::abs(snap.error) <= 1);
+    }
+}
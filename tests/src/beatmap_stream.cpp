@@ -0,0 +1,74 @@
+#include "file_string.h"
+#include <catch2/catch.hpp>
+#include <osu_reader/beatmap_parser.h>
+
+namespace {
+    constexpr const char* filename = "res/Buta-Otome - Kakoi-naki Yo wa Ichigo no Tsukikage (BarkingMadDog) [this map is so bad cuz overmapping].osu";
+
+    struct Counting_visitor {
+        std::size_t circles = 0;
+        std::size_t spinners = 0;
+        std::size_t timingpoints = 0;
+        std::vector<osu::Slider> sliders;
+
+        void operator()(const osu::Hitcircle&) { ++circles; }
+        void operator()(const osu::Slider& slider) { sliders.push_back(slider); }
+        void operator()(const osu::Spinner&) { ++spinners; }
+        void operator()(const osu::Beatmap::Timingpoint&) { ++timingpoints; }
+    };
+}// namespace
+
+TEST_CASE("Stream beatmap")
+{
+    auto parser = osu::Beatmap_parser{};
+    parser.slider_paths = true;
+    const auto full = parser.from_file(filename);
+    REQUIRE(full);
+
+    const auto from_file = GENERATE(true, false);
+    auto visitor = Counting_visitor{};
+    const auto success = from_file ? parser.stream_file(filename, visitor)
+                                   : parser.stream_string(file_string(filename), visitor);
+
+    REQUIRE(success);
+    CHECK(visitor.circles == full->circles.size());
+    CHECK(visitor.spinners == full->spinners.size());
+    CHECK(visitor.timingpoints == full->timingpoints.size());
+    REQUIRE(visitor.sliders.size() == full->sliders.size());
+    for(std::size_t i = 0; i < visitor.sliders.size(); ++i) {
+        CHECK(visitor.sliders[i].time == full->sliders[i].time);
+        CHECK(visitor.sliders[i].duration == full->sliders[i].duration);
+        CHECK(visitor.sliders[i].points == full->sliders[i].points);
+    }
+
+    // Streaming doesn't leave the parser in a different state
+    const auto again = parser.from_file(filename);
+    REQUIRE(again);
+    CHECK(again->sliders.size() == full->sliders.size());
+}
+
+TEST_CASE("Stream beatmap early exit")
+{
+    auto parser = osu::Beatmap_parser{};
+    const auto content = file_string(filename);
+
+    std::vector<std::chrono::milliseconds> times;
+    REQUIRE(parser.stream_string(content, [&](const osu::Slider& slider) {
+        times.push_back(slider.time);
+        return times.size() < 10;
+    }));
+    CHECK(times.size() == 10);
+
+    const auto full = parser.from_string(content);
+    REQUIRE(full);
+    REQUIRE(full->sliders.size() > 10);
+    for(std::size_t i = 0; i < times.size(); ++i) CHECK(times[i] == full->sliders[i].time);
+}
+
+TEST_CASE("Stream missing beatmap")
+{
+    auto parser = osu::Beatmap_parser{};
+    auto calls = 0;
+    CHECK(!parser.stream_file("res/not a file.osu", [&](const auto&) { ++calls; }));
+    CHECK(calls == 0);
+}
@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cpu_features.h>
+#include <hitobject/bezier.h>
+#include <hitobject/bezier_kernels.h>
+#include <limits>
+#include <random>
+#include <stack>
+
+namespace {
+    // The allocating implementation that Bezier_flattener replaced, output has to stay identical
+    std::pair<std::vector<osu::Vector2>, std::vector<osu::Vector2>> reference_subdivide(const std::vector<osu::Vector2>& points)
+    {
+        const auto count = static_cast<int>(points.size());
+        std::vector<osu::Vector2> l(count), r(count);
+
+        auto midpoints = points;
+        for(auto i = 0; i < count; ++i) {
+            l[i] = midpoints[0];
+            r[count - i - 1] = midpoints[count - i - 1];
+
+            for(auto j = 0; j < count - i - 1; ++j) {
+                midpoints[j] = midpoint(midpoints[j], midpoints[j + 1]);
+            }
+        }
+        return {l, r};
+    }
+
+    std::vector<osu::Vector2> reference_bezier(const std::vector<osu::Vector2>& control_points)
+    {
+        std::vector<osu::Vector2> points;
+        std::stack<std::vector<osu::Vector2>> to_flatten;
+        to_flatten.push(control_points);
+
+        while(!to_flatten.empty()) {
+            const auto parent = to_flatten.top();
+            to_flatten.pop();
+
+            auto flat = true;
+            for(auto i = 1; i < static_cast<int>(parent.size()) - 1; ++i) {
+                if(length_squared((parent[i - 1] - 2 * parent[i] + parent[i + 1])) > 0.25f) flat = false;
+            }
+
+            if(flat) {
+                auto [l, r] = reference_subdivide(parent);
+                l.insert(l.end(), r.begin() + 1, r.end());
+                points.push_back(parent[0]);
+                for(auto i = 1; i < static_cast<int>(parent.size()) - 1; ++i) {
+                    const auto index = 2 * i;
+                    points.push_back(0.25f * (l[index - 1] + 2 * l[index] + l[index + 1]));
+                }
+                continue;
+            }
+
+            auto [l, r] = reference_subdivide(parent);
+            to_flatten.push(r);
+            to_flatten.push(l);
+        }
+
+        points.push_back(control_points.back());
+        return points;
+    }
+}// namespace
+
+TEST_CASE("Bezier flattener matches reference")
+{
+    auto rng = std::mt19937{42};
+    auto coordinate = std::uniform_real_distribution<float>{-100.f, 600.f};
+
+    // Reused across curves of different sizes, so stale scratch contents would show up
+    auto flattener = Bezier_flattener{};
+    for(auto curve = 0; curve < 200; ++curve) {
+        const auto count = 1 + curve % 24;
+        std::vector<osu::Vector2> control_points(count);
+        for(auto& point : control_points) point = {coordinate(rng), coordinate(rng)};
+
+        const auto expected = reference_bezier(control_points);
+
+        std::vector<osu::Vector2> points;
+        flattener.flatten(control_points, points);
+        REQUIRE(points == expected);
+
+        std::vector<osu::Vector2> appended;
+        approximate_bezier(control_points, appended);
+        REQUIRE(appended == expected);
+    }
+}
+
+TEST_CASE("Bezier flattener appends")
+{
+    const std::vector<osu::Vector2> control_points{{0, 0}, {50, 100}, {100, 0}};
+
+    auto flattener = Bezier_flattener{};
+    std::vector<osu::Vector2> points{{-1, -1}};
+    flattener.flatten(control_points, points);
+
+    REQUIRE(points.size() > 2);
+    CHECK(points[0] == osu::Vector2{-1, -1});
+    CHECK(points[1] == osu::Vector2{0, 0});
+    CHECK(points.back() == osu::Vector2{100, 0});
+
+    std::vector<osu::Vector2> empty;
+    flattener.flatten({}, empty);
+    CHECK(empty.empty());
+}
+
+TEST_CASE("Bezier tolerance is a distance")
+{
+    const std::vector<osu::Vector2> control_points{{0, 0}, {100, 300}, {250, -200}, {400, 100}};
+
+    // Distance of curve points from de Casteljau's algorithm to the closest segment of the flattened curve
+    const auto deviation = [&control_points](const std::vector<osu::Vector2>& points) {
+        auto largest = 0.f;
+        for(auto step = 0; step <= 1000; ++step) {
+            const auto t = static_cast<float>(step) / 1000;
+            auto curve = control_points;
+            for(auto n = curve.size() - 1; n > 0; --n) {
+                for(std::size_t i = 0; i < n; ++i) curve[i] = (1 - t) * curve[i] + t * curve[i + 1];
+            }
+
+            auto closest = std::numeric_limits<float>::max();
+            for(std::size_t i = 0; i + 1 < points.size(); ++i) {
+                const auto segment = points[i + 1] - points[i];
+                const auto along = std::clamp(dot(curve[0] - points[i], segment) / length_squared(segment), 0.f, 1.f);
+                closest = std::min(closest, length(curve[0] - (points[i] + along * segment)));
+            }
+            largest = std::max(largest, closest);
+        }
+        return largest;
+    };
+
+    std::size_t previous_size = 0;
+    for(const auto tolerance : {2.f, 0.5f, 0.25f, 0.01f}) {
+        std::vector<osu::Vector2> points;
+        approximate_bezier(control_points, points, tolerance);
+        CHECK(deviation(points) <= tolerance);
+        CHECK(points.size() > previous_size);
+        previous_size = points.size();
+    }
+
+    // Subdivision has to stop somewhere
+    std::vector<osu::Vector2> zero, negative, smallest;
+    approximate_bezier(control_points, zero, 0);
+    approximate_bezier(control_points, negative, -1);
+    approximate_bezier(control_points, smallest, 1e-3f);
+    CHECK(zero == smallest);
+    CHECK(negative == smallest);
+}
+
+TEST_CASE("Bezier kernels match Vector2 arithmetic")
+{
+    using osu::cpu::Instruction_set;
+    const auto set = GENERATE(Instruction_set::scalar, Instruction_set::sse2, Instruction_set::avx2);
+    if(!osu::cpu::supports(set)) return;
+
+    auto rng = std::mt19937{7};
+    auto coordinate = std::uniform_real_distribution<float>{-50.f, 50.f};
+
+    // Sizes around and beyond the vector widths exercise all main and tail loops
+    for(std::size_t count = 1; count < 40; ++count) {
+        std::vector<osu::Vector2> points(count);
+        for(auto& point : points) point = {coordinate(rng), coordinate(rng)};
+        // Nearly straight curves, so both flatness outcomes come up
+        if(count % 2 == 0) {
+            for(std::size_t i = 0; i < count; ++i) points[i] = {static_cast<float>(i), 0.1f * coordinate(rng) / static_cast<float>(count)};
+        }
+
+        for(const auto tolerance : {0.25f, 10.f, 1000.f}) {
+            auto flat = true;
+            for(std::size_t i = 1; i + 1 < count; ++i) {
+                if(length_squared((points[i - 1] - 2 * points[i] + points[i + 1])) > tolerance) flat = false;
+            }
+            CHECK(osu::bezier::is_flat_enough(points.data(), count, tolerance, set) == flat);
+        }
+
+        const auto [l, r] = reference_subdivide(points);
+        std::vector<osu::Vector2> midpoints(count + osu::bezier::scratch_padding), sub_l(count), sub_r(count);
+        osu::bezier::subdivide(points.data(), count, midpoints.data(), sub_l.data(), sub_r.data(), set);
+        REQUIRE(sub_l == l);
+        REQUIRE(sub_r == r);
+    }
+}
@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <hitobject/catmull.h>
+#include <random>
+
+namespace {
+    // The spline evaluated in double precision, as the fixed detail approximator did
+    osu::Vector2 reference_point(const std::vector<osu::Vector2>& control_points, const std::size_t i, const double t)
+    {
+        const auto count = control_points.size();
+        const auto v1 = i > 0 ? control_points[i - 1] : control_points[i];
+        const auto v2 = control_points[i];
+        const auto v3 = control_points[i + 1];
+        const auto v4 = i + 2 < count ? control_points[i + 2] : v3 + v3 - v2;
+
+        const auto t2 = t * t;
+        const auto t3 = t * t2;
+        return {
+                static_cast<float>(0.5 * (2 * v2.x + (-v1.x + v3.x) * t + (2 * v1.x - 5 * v2.x + 4 * v3.x - v4.x) * t2 + (-v1.x + 3 * v2.x - 3 * v3.x + v4.x) * t3)),
+                static_cast<float>(0.5 * (2 * v2.y + (-v1.y + v3.y) * t + (2 * v1.y - 5 * v2.y + 4 * v3.y - v4.y) * t2 + (-v1.y + 3 * v2.y - 3 * v3.y + v4.y) * t3))};
+    }
+
+    float distance_to_polyline(const osu::Vector2& p, const std::vector<osu::Vector2>& polyline)
+    {
+        auto best = std::numeric_limits<float>::max();
+        for(std::size_t i = 1; i < polyline.size(); ++i) {
+            const auto a = polyline[i - 1];
+            const auto ab = polyline[i] - a;
+            const auto t = length_squared(ab) > 0 ? std::clamp(dot(p - a, ab) / length_squared(ab), 0.f, 1.f) : 0.f;
+            best = std::min(best, distance(p, a + t * ab));
+        }
+        return best;
+    }
+}// namespace
+
+TEST_CASE("Catmull approximation stays within tolerance")
+{
+    auto rng = std::mt19937{11};
+    auto coordinate = std::uniform_real_distribution<float>{0.f, 512.f};
+
+    for(auto curve = 0; curve < 50; ++curve) {
+        std::vector<osu::Vector2> control_points(2 + curve % 6);
+        for(auto& point : control_points) point = {coordinate(rng), coordinate(rng)};
+
+        std::vector<osu::Vector2> points;
+        approximate_catmull(control_points, points);
+
+        REQUIRE(points.front() == control_points.front());
+        REQUIRE(points.back() == control_points.back());
+        CHECK(std::adjacent_find(points.cbegin(), points.cend()) == points.cend());
+        // The fixed detail approximator emitted 100 points per segment
+        CHECK(points.size() <= 50 * (control_points.size() - 1) + 1);
+
+        // Very sharp segments are capped at the fixed detail, those may be as far off as it was
+        std::vector<osu::Vector2> fixed_detail;
+        for(std::size_t i = 0; i + 1 < control_points.size(); ++i) {
+            for(auto step = 0; step <= 50; ++step) fixed_detail.push_back(reference_point(control_points, i, step / 50.));
+        }
+
+        for(std::size_t i = 0; i + 1 < control_points.size(); ++i) {
+            for(auto sample = 0; sample <= 100; ++sample) {
+                const auto p = reference_point(control_points, i, sample / 100.);
+                CHECK(distance_to_polyline(p, points) <= std::max(0.1f, distance_to_polyline(p, fixed_detail)) + 1e-2f);
+            }
+        }
+    }
+}
+
+TEST_CASE("Catmull approximation appends")
+{
+    std::vector<osu::Vector2> points{{-1, -1}};
+    approximate_catmull({{0, 0}, {100, 0}}, points);
+    REQUIRE(points.size() > 2);
+    CHECK(points.size() < 51);
+    CHECK(points[0] == osu::Vector2{-1, -1});
+    CHECK(points[1] == osu::Vector2{0, 0});
+    CHECK(points.back() == osu::Vector2{100, 0});
+    CHECK(std::all_of(points.cbegin() + 1, points.cend(), [](const auto& p) { return p.y == 0; }));
+
+    std::vector<osu::Vector2> single;
+    approximate_catmull({{5, 5}}, single);
+    CHECK(single.empty());
+}
@@ -10,6 +10,14 @@ TEST_CASE("No Beatmap")
     REQUIRE(!bm_e);
 }
 
+TEST_CASE("Unmappable Path")
+{
+    static auto parser = osu::Beatmap_parser{};
+    const auto bm_e = parser.from_file("res");
+
+    REQUIRE(!bm_e);
+}
+
 TEST_CASE("Empty Line Beginning")
 {
     static constexpr const char* filename = "res/LamazeP - Koi no Program Hatsudou (feat. Hatsune Miku) (Sonnyc) [Euny's Hard].osu";
@@ -54,3 +62,48 @@ TEST_CASE("utf16")
     REQUIRE(bm_e.has_value());
     REQUIRE(bm_e->version == 14);
 }
+
+TEST_CASE("Section mask")
+{
+    static constexpr const char* filename = "res/Buta-Otome - Kakoi-naki Yo wa Ichigo no Tsukikage (BarkingMadDog) [this map is so bad cuz overmapping].osu";
+    using Section = osu::Beatmap_section;
+
+    static auto full_parser = osu::Beatmap_parser{};
+    const auto full = full_parser.from_file(filename);
+    REQUIRE(full);
+
+    // Captured in GENERATE_REF, has to outlive scope
+    static auto parser = osu::Beatmap_parser{};
+    parser.sections = Section::metadata;
+
+    const auto bm_e = GENERATE_REF(
+            parser.from_file(filename),
+            parser.from_string(file_string(filename)));
+
+    REQUIRE(bm_e.has_value());
+    CHECK(bm_e->version == full->version);
+    CHECK(bm_e->title == full->title);
+    CHECK(bm_e->beatmap_id == full->beatmap_id);
+    CHECK(bm_e->audio_file.empty());
+    CHECK(bm_e->timingpoints.empty());
+    CHECK(bm_e->sliders.empty());
+}
+
+TEST_CASE("Section mask hitobjects")
+{
+    static constexpr const char* filename = "res/An - Necro Fantasia-An remix- (captin1) [Normal].osu";
+
+    auto parser = osu::Beatmap_parser{};
+    const auto full = parser.from_file(filename);
+    REQUIRE(full);
+
+    parser.sections = osu::Beatmap_section::hitobjects;
+    const auto bm_e = parser.from_string(file_string(filename));
+
+    REQUIRE(bm_e.has_value());
+    CHECK(bm_e->title.empty());
+    CHECK(bm_e->timingpoints.size() == full->timingpoints.size());
+    REQUIRE(bm_e->sliders.size() == full->sliders.size());
+    CHECK(bm_e->circles.size() == full->circles.size());
+    for(std::size_t i = 0; i < bm_e->sliders.size(); ++i) CHECK(bm_e->sliders[i].duration == full->sliders[i].duration);
+}
@@ -0,0 +1,30 @@
+#include <catch2/catch.hpp>
+#include <key_matcher.h>
+
+using Pair = std::pair<const std::string_view, int>;
+static constexpr osu::Key_matcher matcher{std::array<Pair, 6>{
+        Pair{"HPDrainRate", 0},
+        Pair{"CircleSize", 1},
+        Pair{"OverallDifficulty", 2},
+        Pair{"ApproachRate", 3},
+        Pair{"SliderMultiplier", 4},
+        Pair{"SliderTickRate", 5},
+}};
+
+static_assert(*matcher.find("ApproachRate") == 3);
+static_assert(matcher.find("ApproachRat") == nullptr);
+
+TEST_CASE("Key matcher")
+{
+    CHECK(*matcher.find("HPDrainRate") == 0);
+    CHECK(*matcher.find("CircleSize") == 1);
+    CHECK(*matcher.find("OverallDifficulty") == 2);
+    CHECK(*matcher.find("ApproachRate") == 3);
+    CHECK(*matcher.find("SliderMultiplier") == 4);
+    CHECK(*matcher.find("SliderTickRate") == 5);
+
+    CHECK(matcher.find("") == nullptr);
+    CHECK(matcher.find("SliderTickRat") == nullptr);
+    CHECK(matcher.find("sliderTickRate") == nullptr);
+    CHECK(matcher.find("Title") == nullptr);
+}
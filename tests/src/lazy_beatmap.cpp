@@ -0,0 +1,70 @@
+#include "file_string.h"
+#include <catch2/catch.hpp>
+#include <osu_reader/beatmap_parser.h>
+#include <osu_reader/lazy_beatmap.h>
+
+TEST_CASE("Lazy beatmap sections")
+{
+    static constexpr const char* filename = "res/Buta-Otome - Kakoi-naki Yo wa Ichigo no Tsukikage (BarkingMadDog) [this map is so bad cuz overmapping].osu";
+    using Section = osu::Beatmap_section;
+
+    auto parser = osu::Beatmap_parser{};
+    const auto full = parser.from_file(filename);
+    REQUIRE(full);
+
+    // Lazy beatmaps are move only, which generators can't hold
+    const auto from_file = GENERATE(true, false);
+    auto lazy = from_file ? osu::Lazy_beatmap::from_file(filename)
+                          : osu::Lazy_beatmap::from_string(file_string(filename));
+    REQUIRE(lazy);
+    CHECK(lazy->version() == full->version);
+    CHECK(lazy->parsed() == Section::none);
+    CHECK(osu::has_sections(lazy->available(), Section::general | Section::metadata | Section::hitobjects));
+
+    const auto& metadata = lazy->get(Section::metadata);
+    CHECK(lazy->parsed() == Section::metadata);
+    CHECK(metadata.title == full->title);
+    CHECK(metadata.beatmap_id == full->beatmap_id);
+    CHECK(metadata.audio_file.empty());
+    CHECK(metadata.sliders.empty());
+
+    const auto& objects = lazy->get(Section::hitobjects);
+    CHECK(osu::has_sections(lazy->parsed(), Section::difficulty | Section::timingpoints | Section::hitobjects));
+    CHECK(!osu::has_sections(lazy->parsed(), Section::general));
+    CHECK(objects.timingpoints.size() == full->timingpoints.size());
+    REQUIRE(objects.circles.size() == full->circles.size());
+    REQUIRE(objects.sliders.size() == full->sliders.size());
+    CHECK(objects.spinners.size() == full->spinners.size());
+    for(std::size_t i = 0; i < objects.sliders.size(); ++i) {
+        CHECK(objects.sliders[i].time == full->sliders[i].time);
+        CHECK(objects.sliders[i].duration == full->sliders[i].duration);
+    }
+
+    // Already parsed sections aren't parsed again
+    CHECK(lazy->get(Section::all).sliders.size() == full->sliders.size());
+    CHECK(lazy->get(Section::all).audio_file == full->audio_file);
+}
+
+TEST_CASE("Lazy beatmap utf16")
+{
+    static constexpr const char* filename = "res/An - Necro Fantasia-An remix- (captin1) [Normal].osu";
+
+    auto parser = osu::Beatmap_parser{};
+    const auto full = parser.from_file(filename);
+    REQUIRE(full);
+
+    auto lazy = osu::Lazy_beatmap::from_file(filename);
+    REQUIRE(lazy);
+    CHECK(lazy->version() == full->version);
+
+    const auto& bm = lazy->get(osu::Beatmap_section::all);
+    CHECK(bm.title == full->title);
+    CHECK(bm.circles.size() == full->circles.size());
+    CHECK(bm.sliders.size() == full->sliders.size());
+}
+
+TEST_CASE("Lazy beatmap invalid")
+{
+    CHECK(!osu::Lazy_beatmap::from_file("res/not a file.osu"));
+    CHECK(!osu::Lazy_beatmap::from_string("[General]\nMode: 0\n"));
+}
@@ -0,0 +1,59 @@
+#include <catch2/catch.hpp>
+#include <osu_reader/beatmap_parser.h>
+#include <osu_reader/lazy_slider_paths.h>
+#include <thread>
+
+TEST_CASE("Lazy slider paths")
+{
+    static constexpr const char* filename = "res/Buta-Otome - Kakoi-naki Yo wa Ichigo no Tsukikage (BarkingMadDog) [this map is so bad cuz overmapping].osu";
+
+    auto parser = osu::Beatmap_parser{};
+    const auto beatmap = parser.from_file(filename);
+    parser.slider_paths = true;
+    const auto eager = parser.from_file(filename);
+    REQUIRE(beatmap);
+    REQUIRE(eager);
+    REQUIRE(beatmap->sliders.size() == eager->sliders.size());
+    REQUIRE(!beatmap->sliders.empty());
+    CHECK(beatmap->sliders.front().points.empty());
+
+    const auto paths = osu::Lazy_slider_paths{beatmap->sliders};
+    REQUIRE(paths.size() == beatmap->sliders.size());
+
+    SECTION("Computed on access")
+    {
+        CHECK(!paths.computed(0));
+        const auto& path = paths[0];
+        CHECK(paths.computed(0));
+        CHECK(!paths.computed(1));
+        CHECK(&paths[0] == &path);
+        CHECK(path.points == eager->sliders[0].points);
+        CHECK(path.distances == eager->sliders[0].distances);
+    }
+
+    SECTION("Concurrent readers")
+    {
+        // Every thread walks all sliders from a different start, so most paths are requested concurrently
+        constexpr auto thread_count = 4;
+        std::vector<std::vector<const osu::Lazy_slider_paths::Path*>> seen(thread_count);
+        std::vector<std::thread> threads;
+        for(auto t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&, t] {
+                const auto count = paths.size();
+                seen[t].resize(count);
+                for(std::size_t i = 0; i < count; ++i) {
+                    const auto index = (i + t * count / thread_count) % count;
+                    seen[t][index] = &paths[index];
+                }
+            });
+        }
+        for(auto& thread : threads) thread.join();
+
+        for(std::size_t i = 0; i < paths.size(); ++i) {
+            CHECK(paths.computed(i));
+            for(const auto& pointers : seen) CHECK(pointers[i] == &paths[i]);
+            CHECK(paths[i].points == eager->sliders[i].points);
+            CHECK(paths[i].distances == eager->sliders[i].distances);
+        }
+    }
+}
@@ -0,0 +1,69 @@
+#include <catch2/catch.hpp>
+#include <cstdlib>
+#include <parse_float.h>
+#include <random>
+#include <string>
+
+template<typename Float>
+static Float parse(const std::string& s)
+{
+    Float value = -1;
+    osu::parse_float(s.data(), s.data() + s.size(), value);
+    return value;
+}
+
+TEST_CASE("parse_float values", "[string]")
+{
+    CHECK(parse<float>("256") == 256.f);
+    CHECK(parse<float>("-500") == -500.f);
+    CHECK(parse<float>("+1.5") == 1.5f);
+    CHECK(parse<float>("233.0667") == 233.0667f);
+    CHECK(parse<float>("96.599997052002") == 96.599997052002f);
+    CHECK(parse<float>(".25") == 0.25f);
+    CHECK(parse<float>("1e3") == 1000.f);
+    CHECK(parse<float>("1e") == 1.f);
+    CHECK(parse<double>("1200.0479469394") == 1200.0479469394);
+    CHECK(parse<double>("0.000000000000000000000000001") == 1e-27);
+    CHECK(parse<double>("123456789012345678901234567890") == 123456789012345678901234567890.);
+}
+
+TEST_CASE("parse_float stops at delimiters", "[string]")
+{
+    const std::string s = "380.5:120";
+    auto x = 0.f;
+    const auto result = osu::parse_float(s.data(), s.data() + s.size(), x);
+
+    CHECK(x == 380.5f);
+    REQUIRE(result.ec == std::errc{});
+    CHECK(*result.ptr == ':');
+}
+
+TEST_CASE("parse_float invalid input", "[string]")
+{
+    const std::string s = "abc";
+    auto x = 3.f;
+    const auto result = osu::parse_float(s.data(), s.data() + s.size(), x);
+
+    CHECK(result.ec == std::errc::invalid_argument);
+    CHECK(result.ptr == s.data());
+    CHECK(x == 3.f);
+}
+
+TEST_CASE("parse_float is correctly rounded", "[string]")
+{
+    std::mt19937_64 rng{7};
+    std::uniform_int_distribution<std::int64_t> integer_dist{-99999999, 99999999};
+    std::uniform_int_distribution<int> fraction_digits_dist{0, 12};
+
+    for(auto i = 0; i < 20000; ++i) {
+        auto s = std::to_string(integer_dist(rng));
+        const auto fraction_digits = fraction_digits_dist(rng);
+        if(fraction_digits > 0) {
+            s += '.';
+            for(auto d = 0; d < fraction_digits; ++d) s += static_cast<char>('0' + rng() % 10);
+        }
+
+        CHECK(parse<float>(s) == std::strtof(s.c_str(), nullptr));
+        CHECK(parse<double>(s) == std::strtod(s.c_str(), nullptr));
+    }
+}
@@ -0,0 +1,75 @@
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <hitobject/bezier.h>
+#include <hitobject/perfect_circle.h>
+#include <random>
+
+namespace {
+    // Points on the circle through a, b and c from a to c, evaluated with a sine and cosine each
+    std::vector<osu::Vector2> reference_arc(const osu::Vector2 a, const osu::Vector2 b, const osu::Vector2 c, const std::size_t count)
+    {
+        const auto d = 2. * (a.x * (b.y - c.y) + b.x * (c.y - a.y) + c.x * (a.y - b.y));
+        const auto a_sq = static_cast<double>(length_squared(a));
+        const auto b_sq = static_cast<double>(length_squared(b));
+        const auto c_sq = static_cast<double>(length_squared(c));
+        const auto centre_x = (a_sq * (b.y - c.y) + b_sq * (c.y - a.y) + c_sq * (a.y - b.y)) / d;
+        const auto centre_y = (a_sq * (c.x - b.x) + b_sq * (a.x - c.x) + c_sq * (b.x - a.x)) / d;
+        const auto radius = std::hypot(a.x - centre_x, a.y - centre_y);
+
+        const auto theta_start = std::atan2(a.y - centre_y, a.x - centre_x);
+        auto theta_end = std::atan2(c.y - centre_y, c.x - centre_x);
+        while(theta_end < theta_start) theta_end += 2 * M_PI;
+        auto range = theta_end - theta_start;
+        auto direction = 1.;
+        if((c.y - a.y) * (b.x - a.x) - (c.x - a.x) * (b.y - a.y) < 0) {
+            direction = -1;
+            range = 2 * M_PI - range;
+        }
+
+        std::vector<osu::Vector2> points;
+        for(std::size_t i = 0; i < count; ++i) {
+            const auto theta = theta_start + direction * range * static_cast<double>(i) / static_cast<double>(count - 1);
+            points.push_back({static_cast<float>(centre_x + radius * std::cos(theta)), static_cast<float>(centre_y + radius * std::sin(theta))});
+        }
+        return points;
+    }
+}// namespace
+
+TEST_CASE("Perfect circle arc matches trigonometry")
+{
+    auto rng = std::mt19937{3};
+    auto coordinate = std::uniform_real_distribution<float>{0.f, 512.f};
+
+    for(auto arc = 0; arc < 200; ++arc) {
+        const std::vector<osu::Vector2> control_points{{coordinate(rng), coordinate(rng)},
+                                                        {coordinate(rng), coordinate(rng)},
+                                                        {coordinate(rng), coordinate(rng)}};
+        const auto& [a, b, c] = std::tie(control_points[0], control_points[1], control_points[2]);
+        // Nearly collinear points fall back to bezier curves
+        if(std::abs((b.y - a.y) * (c.x - a.x) - (b.x - a.x) * (c.y - a.y)) <= 1.f) continue;
+
+        std::vector<osu::Vector2> points;
+        approximate_perfect(control_points, points);
+        REQUIRE(points.size() >= 2);
+
+        const auto expected = reference_arc(a, b, c, points.size());
+        for(std::size_t i = 0; i < points.size(); ++i) {
+            CHECK(points[i].x == Approx(expected[i].x).margin(1e-2));
+            CHECK(points[i].y == Approx(expected[i].y).margin(1e-2));
+        }
+        CHECK(distance(points.front(), a) < 1e-2f);
+        CHECK(distance(points.back(), c) < 1e-2f);
+    }
+}
+
+TEST_CASE("Perfect circle arc of huge radius falls back to bezier")
+{
+    // Nearly collinear but not degenerate, the radius is so large that 1 - tolerance / radius rounds to 1
+    const std::vector<osu::Vector2> control_points{{0, 0}, {1e8f, 1}, {2e8f, 0}};
+
+    std::vector<osu::Vector2> points;
+    approximate_perfect(control_points, points);
+    std::vector<osu::Vector2> bezier;
+    approximate_bezier(control_points, bezier);
+    CHECK(points == bezier);
+}
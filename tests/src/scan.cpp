@@ -0,0 +1,112 @@
+#include <array>
+#include <catch2/catch.hpp>
+#include <cpu_features.h>
+#include <osu_reader/string_stuff.h>
+#include <random>
+#include <scan.h>
+#include <string>
+#include <vector>
+
+static std::vector<std::uint32_t> naive_find_all(const std::string_view s, const char c)
+{
+    std::vector<std::uint32_t> positions;
+    for(std::size_t i = 0; i < s.size(); ++i) {
+        if(s[i] == c) positions.push_back(static_cast<std::uint32_t>(i));
+    }
+    return positions;
+}
+
+TEST_CASE("scan find", "[string]")
+{
+    const std::string s = "256,192,74363,118,0,B|208:4|8:8|8:8|40:36|48:63,1,1200.0479469394\nnext line";
+
+    CHECK(osu::scan::find(s, ',') == s.find(','));
+    CHECK(osu::scan::find(s, '\n') == s.find('\n'));
+    CHECK(osu::scan::find(s, ':', 30) == s.find(':', 30));
+    CHECK(osu::scan::find(s, '[') == std::string_view::npos);
+    CHECK(osu::scan::find(s, ',', s.size()) == std::string_view::npos);
+    CHECK(osu::scan::find("", ',') == std::string_view::npos);
+}
+
+TEST_CASE("scan find matches naive search", "[string]")
+{
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<int> char_dist{0, 3};
+    constexpr std::array<char, 4> alphabet{',', '|', 'a', ':'};
+
+    for(auto length = 0; length < 200; ++length) {
+        std::string s(length, ' ');
+        for(auto& c : s) c = alphabet[char_dist(rng)];
+
+        for(const auto c : {',', '|', ':', '\n'}) {
+            const auto expected = naive_find_all(s, c);
+
+            std::vector<std::uint32_t> positions(s.size() + 1);
+            const auto count = osu::scan::find_all(s, c, positions.data(), positions.size());
+            positions.resize(count);
+            CHECK(positions == expected);
+
+            for(std::size_t start = 0; start < s.size(); start += 7) {
+                CHECK(osu::scan::find(s, c, start) == s.find(c, start));
+            }
+        }
+    }
+}
+
+TEST_CASE("scan implementations match naive search", "[string]")
+{
+    using osu::cpu::Instruction_set;
+    const auto set = GENERATE(Instruction_set::scalar, Instruction_set::sse2, Instruction_set::avx2);
+    if(!osu::cpu::supports(set)) return;
+
+    std::mt19937 rng{7};
+    std::uniform_int_distribution<int> char_dist{0, 3};
+    constexpr std::array<char, 4> alphabet{',', '|', 'a', ':'};
+
+    // Lengths beyond two AVX2 blocks exercise the block loops and all tails
+    for(auto length = 0; length < 100; ++length) {
+        std::string s(length, ' ');
+        for(auto& c : s) c = alphabet[char_dist(rng)];
+
+        for(const auto c : {',', '|', '\n'}) {
+            const auto expected = naive_find_all(s, c);
+
+            std::vector<std::uint32_t> positions(s.size() + 1);
+            positions.resize(osu::scan::find_all(s, c, positions.data(), positions.size(), set));
+            CHECK(positions == expected);
+
+            // Stopping at capacity, including in the middle of a block
+            const auto capacity = expected.size() / 2;
+            std::vector<std::uint32_t> limited(capacity);
+            limited.resize(osu::scan::find_all(s, c, limited.data(), capacity, set));
+            CHECK(limited == std::vector<std::uint32_t>(expected.begin(), expected.begin() + static_cast<std::ptrdiff_t>(capacity)));
+
+            for(std::size_t start = 0; start <= s.size(); start += 3) {
+                CHECK(osu::scan::find(s, c, start, set) == s.find(c, start));
+            }
+        }
+    }
+}
+
+TEST_CASE("scan find_all capacity", "[string]")
+{
+    const std::string s(100, ',');
+    std::array<std::uint32_t, 37> positions{};
+
+    REQUIRE(osu::scan::find_all(s, ',', positions.data(), positions.size()) == positions.size());
+    CHECK(positions.front() == 0);
+    CHECK(positions.back() == 36);
+    CHECK(osu::scan::find_all(s, ',', positions.data(), 0) == 0);
+}
+
+TEST_CASE("split long string", "[string]")
+{
+    std::string s;
+    for(auto i = 0; i < 1000; ++i) s += std::to_string(i) + (i % 3 == 0 ? ",," : ",");
+
+    const auto splits = osu::split(s, ',');
+    REQUIRE(splits.size() == 1000);
+    CHECK(splits[0] == "0");
+    CHECK(splits[64] == "64");
+    CHECK(splits[999] == "999");
+}
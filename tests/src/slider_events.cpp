@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <hitobject/parse_hitobject.h>
+#include <osu_reader/beatmap_parser.h>
+#include <osu_reader/slider_events.h>
+#include <osu_reader/sliderpath.h>
+#include <osu_reader/string_stuff.h>
+
+using namespace std::chrono_literals;
+using Type = osu::Slider_event::Type;
+
+TEST_CASE("Slider events of a repeating slider")
+{
+    osu::Beatmap beatmap{};
+    beatmap.version = 14;
+    beatmap.slider_multiplier = 1.4f;
+    beatmap.slider_tick_rate = 2;
+    beatmap.timingpoints.push_back({0ms, 500ms, 4, 0, 0, 100, true, false});
+    beatmap.sliders.push_back(parse_slider(osu::split("0,0,1000,2,0,L|140:0,2,140", ',')).value());
+    beatmap.circles.push_back({{0, 0}, 3000ms});
+
+    const auto with_path = GENERATE(true, false);
+    if(with_path) osu::compute_slider_path(beatmap.sliders.front());
+
+    const auto events = osu::slider_events(beatmap);
+    REQUIRE(events.size() == 5);
+
+    const std::vector<Type> types{Type::head, Type::tick, Type::repeat, Type::tick, Type::tail};
+    const std::vector<std::chrono::microseconds> times{1000ms, 1250ms, 1500ms, 1750ms, 2000ms};
+    const std::vector<osu::Vector2> positions{{0, 0}, {70, 0}, {140, 0}, {70, 0}, {0, 0}};
+    for(std::size_t i = 0; i < events.size(); ++i) {
+        CHECK(events[i].type == types[i]);
+        CHECK(events[i].time == times[i]);
+        CHECK(events[i].pos == positions[i]);
+        CHECK(events[i].slider == 0);
+    }
+
+    CHECK(osu::max_combo(beatmap) == 6);
+}
+
+TEST_CASE("Slider events of a beatmap")
+{
+    static constexpr const char* filename = "res/LamazeP - Koi no Program Hatsudou (feat. Hatsune Miku) (Sonnyc) [Euny's Hard].osu";
+
+    auto parser = osu::Beatmap_parser{};
+    const auto beatmap = parser.from_file(filename);
+    parser.slider_paths = true;
+    const auto with_paths = parser.from_file(filename);
+    REQUIRE(beatmap);
+    REQUIRE(with_paths);
+    CHECK(beatmap->slider_tick_rate == 2.f);
+
+    const auto events = osu::slider_events(*beatmap);
+    CHECK(std::is_sorted(events.cbegin(), events.cend(), [](const auto& a, const auto& b) { return a.time < b.time; }));
+    CHECK(static_cast<std::size_t>(std::count_if(events.cbegin(), events.cend(), [](const auto& e) { return e.type == Type::head; })) == beatmap->sliders.size());
+    CHECK(static_cast<std::size_t>(std::count_if(events.cbegin(), events.cend(), [](const auto& e) { return e.type == Type::tail; })) == beatmap->sliders.size());
+    CHECK(std::any_of(events.cbegin(), events.cend(), [](const auto& e) { return e.type == Type::tick; }));
+    CHECK(osu::max_combo(*beatmap) == beatmap->circles.size() + beatmap->spinners.size() + events.size());
+
+    // Tails are where the parsed duration says, which is rounded down to milliseconds
+    for(const auto& event : events) {
+        if(event.type != Type::tail) continue;
+        const auto& slider = beatmap->sliders[event.slider];
+        const auto expected = std::chrono::microseconds{slider.time + slider.repeat * slider.duration};
+        CHECK(event.time >= expected);
+        CHECK(event.time - expected <= std::chrono::microseconds{slider.repeat * 1000});
+    }
+
+    // Paths computed on the fly are the parsed ones
+    const auto parsed_path_events = osu::slider_events(*with_paths);
+    REQUIRE(parsed_path_events.size() == events.size());
+    for(std::size_t i = 0; i < events.size(); ++i) {
+        CHECK(parsed_path_events[i].time == events[i].time);
+        CHECK(parsed_path_events[i].pos == events[i].pos);
+    }
+}
@@ -1,22 +1,31 @@
+#include <algorithm>
 #include <catch2/catch.hpp>
+#include <hitobject/bezier.h>
+#include <hitobject/catmull.h>
 #include <hitobject/parse_hitobject.h>
+#include <hitobject/perfect_circle.h>
+#include <osu_reader/beatmap_parser.h>
 #include <osu_reader/sliderpath.h>
 #include <osu_reader/string_stuff.h>
+#include <string>
 
 using Segments = std::vector<osu::Slider::Segment>;
 
-static bool operator==(const Segments& a, const Segments& b)
-{
-    if(a.size() != b.size()) return false;
+namespace osu {
+    // Lives in osu so that argument dependent lookup finds it from within Catch's comparison
+    static bool operator==(const Segments& a, const Segments& b)
+    {
+        if(a.size() != b.size()) return false;
 
-    for(auto i = 0; i < a.size(); ++i) {
-        if(a[i].type != b[i].type) return false;
+        for(auto i = 0; i < a.size(); ++i) {
+            if(a[i].type != b[i].type) return false;
 
-        if(!std::equal(a[i].points.cbegin(), a[i].points.cend(), b[i].points.cbegin(), b[i].points.cend()))
-            return false;
+            if(!std::equal(a[i].points.cbegin(), a[i].points.cend(), b[i].points.cbegin(), b[i].points.cend()))
+                return false;
+        }
+        return true;
     }
-    return true;
-}
+}// namespace osu
 
 TEST_CASE("Linear Slider")
 {
@@ -244,3 +253,193 @@ TEST_CASE("Point cleanup")
     CHECK(slider->points.front() == osu::Vector2{0, 0});
     CHECK(slider->points.back() == osu::Vector2{100, 0});
 }
+
+TEST_CASE("Point cleanup matches erase loop")
+{
+    // Quadratic cleanup that sliderpath used to do, without reading before the first point
+    const auto reference_cleanup = [](std::vector<osu::Vector2> path) {
+        path.erase(std::unique(path.begin(), path.end()), path.end());
+        for(std::size_t i = 2; i < path.size(); ++i) {
+            if(normal(path[i - 2] - path[i - 1]) == normal(path[i - 1] - path[i])) {
+                path.erase(path.begin() + static_cast<std::ptrdiff_t>(i) - 1);
+                --i;
+            }
+        }
+        return path;
+    };
+
+    const auto slider_string = GENERATE(
+            "0,0,50000,2,0,L|0:0|10:0|20:0|20:0|20:10|20:20|30:30|40:40|40:40,1,100",
+            "0,0,50000,2,0,C|50:50|100:0|150:50|200:0|200:0|250:50,1,300",
+            "256,192,74363,118,0,B|208:4|8:8|8:8|40:36|48:63|48:63|44:104|44:104|92:128|76:188|76:188|112:204,1,600",
+            "0,0,50000,2,0,P|50:50|100:0,1,150");
+    const auto slider = parse_slider(osu::split(slider_string, ','));
+    REQUIRE(slider);
+
+    // Concatenation of the segment approximations before any cleanup
+    std::vector<osu::Vector2> raw;
+    for(const auto& segment : slider->segments) {
+        switch(segment.type) {
+            case osu::Slider::Slider_type::perfect:
+                approximate_perfect(segment.points, raw);
+                break;
+            case osu::Slider::Slider_type::bezier:
+                approximate_bezier(segment.points, raw);
+                break;
+            case osu::Slider::Slider_type::catmull:
+                approximate_catmull(segment.points, raw);
+                break;
+            default:
+                raw.insert(raw.end(), segment.points.cbegin(), segment.points.cend());
+        }
+    }
+    CHECK(osu::sliderpath(*slider) == reference_cleanup(raw));
+
+    auto with_duplicates = raw;
+    for(std::size_t i = 0; i < raw.size(); i += 3) with_duplicates.insert(with_duplicates.begin() + static_cast<std::ptrdiff_t>(i), raw[i]);
+
+    auto linear = *slider;
+    linear.segments = {{with_duplicates, osu::Slider::Slider_type::linear}};
+    CHECK(osu::sliderpath(linear) == reference_cleanup(with_duplicates));
+
+    std::vector<osu::Vector2> reused{{-1, -1}, {-2, -2}};
+    osu::sliderpath(*slider, reused);
+    CHECK(reused == osu::sliderpath(*slider));
+}
+
+TEST_CASE("Parallel slider paths")
+{
+    static constexpr const char* filename = "res/Buta-Otome - Kakoi-naki Yo wa Ichigo no Tsukikage (BarkingMadDog) [this map is so bad cuz overmapping].osu";
+
+    auto parser = osu::Beatmap_parser{};
+    parser.slider_paths = true;
+    const auto serial = parser.from_file(filename);
+    parser.path_threads = 4;
+    const auto parallel = parser.from_file(filename);
+    REQUIRE(serial);
+    REQUIRE(parallel);
+
+    // Repeated until it's large enough to be split into chunks
+    std::vector<osu::Slider> sliders;
+    while(sliders.size() < 2000) sliders.insert(sliders.end(), serial->sliders.cbegin(), serial->sliders.cend());
+    for(auto& slider : sliders) {
+        slider.points.clear();
+        slider.distances.clear();
+    }
+    osu::compute_slider_paths(sliders, 4);
+
+    REQUIRE(parallel->sliders.size() == serial->sliders.size());
+    for(std::size_t i = 0; i < serial->sliders.size(); ++i) {
+        CHECK(parallel->sliders[i].points == serial->sliders[i].points);
+        CHECK(parallel->sliders[i].distances == serial->sliders[i].distances);
+    }
+    for(std::size_t i = 0; i < sliders.size(); ++i) {
+        CHECK(sliders[i].points == serial->sliders[i % serial->sliders.size()].points);
+        CHECK(sliders[i].distances == serial->sliders[i % serial->sliders.size()].distances);
+    }
+
+    // Large enough for the parser's workers, which the second parse reuses
+    std::string content = "osu file format v14\n\n[Difficulty]\nSliderMultiplier:1.4\n\n[TimingPoints]\n0,400,4,2,0,60,1,0\n\n[HitObjects]\n";
+    for(auto i = 0; i < 600; ++i) {
+        content += std::to_string(i % 512) + ",64," + std::to_string(i * 100) + ",2,0,B|" + std::to_string(i % 300) + ":200|300:" +
+                   std::to_string(i % 97) + "|400:64,1," + std::to_string(100 + i % 200) + "\n";
+    }
+    parser.path_threads = 1;
+    const auto large_serial = parser.from_string(content);
+    const auto serial_deviation = parser.path_deviation();
+    CHECK(serial_deviation > 0);
+    parser.path_threads = 3;
+    for(auto parse = 0; parse < 2; ++parse) {
+        const auto large_parallel = parser.from_string(content);
+        REQUIRE(large_serial);
+        REQUIRE(large_parallel);
+        CHECK(parser.path_deviation() == serial_deviation);
+        REQUIRE(large_parallel->sliders.size() == 600);
+        for(std::size_t i = 0; i < large_serial->sliders.size(); ++i) {
+            CHECK(large_parallel->sliders[i].points == large_serial->sliders[i].points);
+        }
+    }
+}
+
+TEST_CASE("Path simplification")
+{
+    const auto slider = parse_slider(osu::split("0,0,50000,2,0,L|10:0.1|20:0|30:-0.1|40:0,1,40", ',')).value();
+
+    std::vector<osu::Vector2> path;
+    auto quality = osu::Path_quality{};
+    quality.simplify_tolerance = 0.5f;
+    const auto deviation = osu::sliderpath(slider, path, quality);
+    CHECK(path == std::vector<osu::Vector2>{{0, 0}, {40, 0}});
+    CHECK(deviation == Approx(0.1f));
+
+    quality.simplify_tolerance = 0.05f;
+    CHECK(osu::sliderpath(slider, path, quality) == 0.f);
+    // 20:0 is already dropped for lying on the line between its neighbours
+    CHECK(path.size() == 4);
+}
+
+TEST_CASE("Path quality levels")
+{
+    static constexpr const char* filename = "res/Buta-Otome - Kakoi-naki Yo wa Ichigo no Tsukikage (BarkingMadDog) [this map is so bad cuz overmapping].osu";
+
+    auto parser = osu::Beatmap_parser{};
+    const auto beatmap = parser.from_file(filename);
+    REQUIRE(beatmap);
+
+    const auto distance_to_path = [](const osu::Vector2& p, const std::vector<osu::Vector2>& path) {
+        auto best = distance(p, path.front());
+        for(std::size_t i = 1; i < path.size(); ++i) {
+            const auto ab = path[i] - path[i - 1];
+            const auto t = std::clamp(dot(p - path[i - 1], ab) / length_squared(ab), 0.f, 1.f);
+            best = std::min(best, distance(p, path[i - 1] + t * ab));
+        }
+        return best;
+    };
+
+    // Close enough to the exact curves to measure the other paths against
+    const auto fine_quality = osu::Path_quality{0.01f, 0.01f, 0.01f, 0};
+
+    std::size_t exact_points = 0;
+    std::size_t thumbnail_points = 0;
+    auto largest_deviation = 0.f;
+    std::vector<osu::Vector2> exact;
+    std::vector<osu::Vector2> fine;
+    std::vector<osu::Vector2> unsimplified;
+    std::vector<osu::Vector2> thumbnail;
+    for(const auto& slider : beatmap->sliders) {
+        const auto linear = std::all_of(slider.segments.cbegin(), slider.segments.cend(), [](const auto& segment) {
+            return segment.type == osu::Slider::Slider_type::linear;
+        });
+        const auto exact_deviation = osu::sliderpath(slider, exact, osu::Path_quality::exact());
+        CHECK((exact_deviation == 0.f) == linear);
+        const auto fine_deviation = osu::sliderpath(slider, fine, fine_quality);
+
+        auto quality = osu::Path_quality::thumbnail();
+        const auto simplify_tolerance = quality.simplify_tolerance;
+        quality.simplify_tolerance = 0;
+        const auto approximation_deviation = osu::sliderpath(slider, unsimplified, quality);
+        quality.simplify_tolerance = simplify_tolerance;
+        const auto deviation = osu::sliderpath(slider, thumbnail, quality);
+        largest_deviation = std::max(largest_deviation, deviation);
+
+        exact_points += exact.size();
+        thumbnail_points += thumbnail.size();
+        CHECK(thumbnail.front() == exact.front());
+        CHECK(thumbnail.back() == unsimplified.back());
+
+        // Simplification adds what it actually did to the error bound of the approximation
+        CHECK(deviation - approximation_deviation <= simplify_tolerance);
+        for(const auto& point : unsimplified) CHECK(distance_to_path(point, thumbnail) <= deviation - approximation_deviation + 1e-3f);
+        // And the total bounds the distance to the exact curves
+        for(const auto& point : fine) CHECK(distance_to_path(point, thumbnail) <= deviation + fine_deviation + 1e-3f);
+    }
+    CHECK(thumbnail_points < exact_points);
+
+    parser.slider_paths = true;
+    parser.path_quality = osu::Path_quality::thumbnail();
+    REQUIRE(parser.from_file(filename));
+    CHECK(parser.path_deviation() == largest_deviation);
+    parser.slider_paths = false;
+    REQUIRE(parser.from_file(filename));
+    CHECK(parser.path_deviation() == 0.f);
+}
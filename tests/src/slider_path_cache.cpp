@@ -0,0 +1,125 @@
+#include <catch2/catch.hpp>
+#include <osu_reader/beatmap_parser.h>
+#include <osu_reader/slider_path_cache.h>
+#include <osu_reader/sliderpath.h>
+#include <thread>
+
+namespace {
+    constexpr const char* filename = "res/Buta-Otome - Kakoi-naki Yo wa Ichigo no Tsukikage (BarkingMadDog) [this map is so bad cuz overmapping].osu";
+}
+
+TEST_CASE("Slider path cache shared by parsers")
+{
+    auto parser = osu::Beatmap_parser{};
+    parser.slider_paths = true;
+    const auto expected = parser.from_file(filename);
+    REQUIRE(expected);
+
+    const auto cache = std::make_shared<osu::Slider_path_cache>();
+    auto first_parser = osu::Beatmap_parser{};
+    auto second_parser = osu::Beatmap_parser{};
+    for(auto* cached_parser : {&first_parser, &second_parser}) {
+        cached_parser->slider_paths = true;
+        cached_parser->path_cache = cache;
+    }
+
+    const auto first = first_parser.from_file(filename);
+    const auto after_first = cache->stats();
+    const auto second = second_parser.from_file(filename);
+    const auto after_second = cache->stats();
+    REQUIRE(first);
+    REQUIRE(second);
+
+    CHECK(after_first.misses == after_first.entries);
+    CHECK(after_first.hits + after_first.misses == expected->sliders.size());
+    CHECK(after_second.hits == after_first.hits + expected->sliders.size());
+    CHECK(after_second.misses == after_first.misses);
+    CHECK(after_second.hit_rate() >= 0.5);
+    CHECK(after_second.evictions == 0);
+
+    for(std::size_t i = 0; i < expected->sliders.size(); ++i) {
+        CHECK(first->sliders[i].points == expected->sliders[i].points);
+        CHECK(first->sliders[i].distances == expected->sliders[i].distances);
+        CHECK(second->sliders[i].points == expected->sliders[i].points);
+        CHECK(second->sliders[i].distances == expected->sliders[i].distances);
+    }
+
+    cache->clear();
+    CHECK(cache->stats().entries == 0);
+    CHECK(cache->stats().hits == 0);
+}
+
+TEST_CASE("Slider path cache keys")
+{
+    auto parser = osu::Beatmap_parser{};
+    const auto beatmap = parser.from_file(filename);
+    REQUIRE(beatmap);
+    REQUIRE(beatmap->sliders.size() >= 2);
+
+    auto cache = osu::Slider_path_cache{};
+    auto slider = beatmap->sliders.front();
+    const auto path = cache.get(slider);
+    CHECK(cache.get(slider) == path);
+    CHECK(cache.get(slider, osu::Path_quality::thumbnail()) != path);
+
+    slider.length += 1;
+    const auto longer = cache.get(slider);
+    CHECK(longer != path);
+    CHECK(longer->distances.back() == slider.length);
+
+    slider.segments.front().points.back().x += 1;
+    CHECK(cache.get(slider) != longer);
+    CHECK(cache.stats().entries == 4);
+}
+
+TEST_CASE("Slider path cache eviction")
+{
+    auto parser = osu::Beatmap_parser{};
+    const auto beatmap = parser.from_file(filename);
+    REQUIRE(beatmap);
+    REQUIRE(beatmap->sliders.size() >= 3);
+
+    // Too small for more than one path
+    auto cache = osu::Slider_path_cache{1};
+    const auto first = cache.get(beatmap->sliders[0]);
+    cache.get(beatmap->sliders[1]);
+    cache.get(beatmap->sliders[2]);
+
+    const auto stats = cache.stats();
+    CHECK(stats.entries == 1);
+    CHECK(stats.evictions == 2);
+    // Held paths outlive their eviction
+    auto expected = beatmap->sliders[0];
+    osu::compute_slider_path(expected);
+    CHECK(first->points == expected.points);
+    CHECK(cache.get(beatmap->sliders[0]) != first);
+}
+
+TEST_CASE("Slider path cache concurrent readers")
+{
+    auto parser = osu::Beatmap_parser{};
+    const auto beatmap = parser.from_file(filename);
+    REQUIRE(beatmap);
+
+    auto cache = osu::Slider_path_cache{};
+    constexpr auto thread_count = 4;
+    std::vector<std::vector<osu::Slider>> results(thread_count, beatmap->sliders);
+    std::vector<std::thread> threads;
+    for(auto t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&, t] {
+            for(auto& slider : results[t]) cache.compute(slider);
+        });
+    }
+    for(auto& thread : threads) thread.join();
+
+    auto expected = beatmap->sliders;
+    for(auto& slider : expected) osu::compute_slider_path(slider);
+    for(const auto& sliders : results) {
+        for(std::size_t i = 0; i < sliders.size(); ++i) {
+            CHECK(sliders[i].points == expected[i].points);
+            CHECK(sliders[i].distances == expected[i].distances);
+        }
+    }
+    const auto stats = cache.stats();
+    CHECK(stats.hits + stats.misses == thread_count * beatmap->sliders.size());
+}
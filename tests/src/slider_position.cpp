@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <hitobject/parse_hitobject.h>
+#include <osu_reader/slider_position.h>
+#include <osu_reader/sliderpath.h>
+#include <osu_reader/string_stuff.h>
+#include <random>
+
+namespace {
+    osu::Slider path_slider(const char* slider_string)
+    {
+        auto slider = parse_slider(osu::split(slider_string, ',')).value();
+        osu::compute_slider_path(slider);
+        return slider;
+    }
+
+    // Linear walk over the path, which the searches have to agree with
+    osu::Vector2 reference_position(const osu::Slider& slider, const float distance)
+    {
+        for(std::size_t i = 1; i < slider.points.size(); ++i) {
+            if(distance < slider.distances[i]) {
+                const auto t = (distance - slider.distances[i - 1]) / (slider.distances[i] - slider.distances[i - 1]);
+                return lerp(slider.points[i - 1], slider.points[i], std::max(t, 0.f));
+            }
+        }
+        return slider.points.back();
+    }
+}// namespace
+
+TEST_CASE("Slider position with repeats")
+{
+    auto slider = path_slider("0,0,1000,2,0,L|100:0,3,100");
+    slider.duration = std::chrono::milliseconds{100};
+
+    CHECK(osu::position_at_progress(slider, 0) == osu::Vector2{0, 0});
+    CHECK(osu::position_at_progress(slider, 1.f / 6) == osu::Vector2{50, 0});
+    CHECK(osu::position_at_progress(slider, 0.5f) == osu::Vector2{50, 0});
+    CHECK(osu::position_at_progress(slider, 1) == osu::Vector2{100, 0});
+    CHECK(osu::position_at_progress(slider, 2) == osu::Vector2{100, 0});
+
+    CHECK(osu::position_at_time(slider, std::chrono::milliseconds{0}) == osu::Vector2{0, 0});
+    CHECK(osu::position_at_time(slider, std::chrono::milliseconds{1100}) == osu::Vector2{100, 0});
+    CHECK(osu::position_at_time(slider, std::chrono::milliseconds{1125}) == osu::Vector2{75, 0});
+    CHECK(osu::position_at_time(slider, std::chrono::milliseconds{1250}) == osu::Vector2{50, 0});
+    CHECK(osu::position_at_time(slider, std::chrono::milliseconds{5000}) == osu::Vector2{100, 0});
+}
+
+TEST_CASE("Slider position without path")
+{
+    auto slider = parse_slider(osu::split("20,30,1000,2,0,L|100:0,1,100", ',')).value();
+    CHECK(osu::position_at_progress(slider, 0.5f) == osu::Vector2{20, 30});
+
+    std::vector<osu::Vector2> positions;
+    osu::positions_at_times(slider, {std::chrono::milliseconds{1000}, std::chrono::milliseconds{1050}}, positions);
+    CHECK(positions == std::vector<osu::Vector2>{{20, 30}, {20, 30}});
+}
+
+TEST_CASE("Batched slider positions match single queries")
+{
+    const auto slider = path_slider("256,192,74363,118,0,B|208:4|8:8|8:8|40:36|48:63|48:63|44:104|44:104|92:128|76:188|76:188|112:204|152:192|152:192|56:248|32:360|32:360|64:332|100:332|100:332|152:348|196:320|196:320|216:280|256:276|256:276|261:255|261:255|254:246|254:246|259:238|259:238|251:236|251:236|263:225|263:225|253:214|253:214|262:205|262:205|256:201|256:201|256:160,2,1200.0479469394");
+    REQUIRE(slider.points.size() > 10);
+
+    auto rng = std::mt19937{7};
+    auto distribution = std::uniform_real_distribution<float>{-0.1f, 1.1f};
+    std::vector<float> progress(500);
+    for(auto& p : progress) p = distribution(rng);
+    const auto sorted = GENERATE(true, false);
+    if(sorted) std::sort(progress.begin(), progress.end());
+
+    std::vector<osu::Vector2> positions;
+    osu::positions_at_progress(slider, progress, positions);
+    REQUIRE(positions.size() == progress.size());
+    for(std::size_t i = 0; i < progress.size(); ++i) {
+        CHECK(positions[i] == osu::position_at_progress(slider, progress[i]));
+
+        const auto spans = 2 * std::clamp(progress[i], 0.f, 1.f);
+        const auto local = spans <= 1 ? spans : 2 - spans;
+        const auto expected = reference_position(slider, local * slider.distances.back());
+        CHECK(positions[i].x == Approx(expected.x).margin(1e-3));
+        CHECK(positions[i].y == Approx(expected.y).margin(1e-3));
+    }
+}
+
+TEST_CASE("Arc length table matches searches")
+{
+    const auto slider = path_slider("256,192,74363,118,0,B|208:4|8:8|8:8|40:36|48:63|48:63|44:104|44:104|92:128|76:188|76:188|112:204|152:192|152:192|56:248|32:360|32:360|64:332|100:332|100:332|152:348|196:320|196:320|216:280|256:276|256:276|261:255|261:255|254:246|254:246|259:238|259:238|251:236|251:236|263:225|263:225|253:214|253:214|262:205|262:205|256:201|256:201|256:160,2,1200.0479469394");
+    const auto buckets = GENERATE(std::size_t{0}, std::size_t{1}, std::size_t{7}, std::size_t{5000});
+    const auto table = osu::Arc_length_table{slider, buckets};
+    CHECK(table.length() == slider.distances.back());
+
+    auto rng = std::mt19937{11};
+    auto distribution = std::uniform_real_distribution<float>{-0.1f, 1.1f};
+    for(auto i = 0; i < 1000; ++i) {
+        const auto progress = distribution(rng);
+        const auto distance = progress * table.length();
+        CHECK(table.at_distance(distance) == osu::position_at_distance(slider.points, slider.distances, distance));
+        CHECK(osu::position_at_progress(slider, table, progress) == osu::position_at_progress(slider, progress));
+    }
+    // Every path point is a segment boundary
+    for(const auto distance : slider.distances) {
+        CHECK(table.at_distance(distance) == osu::position_at_distance(slider.points, slider.distances, distance));
+    }
+    CHECK(table.at_fraction(1) == slider.points.back());
+    CHECK(osu::position_at_time(slider, table, slider.time) == slider.points.front());
+}
+
+TEST_CASE("Arc length table without path")
+{
+    const auto slider = parse_slider(osu::split("20,30,1000,2,0,L|100:0,1,100", ',')).value();
+    const auto table = osu::Arc_length_table{slider};
+    CHECK(table.length() == 0);
+    CHECK(table.at_fraction(0.5f) == osu::Vector2{20, 30});
+    CHECK(osu::Arc_length_table{}.at_distance(1) == osu::Vector2{0, 0});
+
+    std::vector<osu::Vector2> resampled;
+    table.resample(3, resampled);
+    CHECK(resampled == std::vector<osu::Vector2>{{20, 30}, {20, 30}, {20, 30}});
+}
+
+TEST_CASE("Equidistant resampling")
+{
+    const auto line = path_slider("0,0,1000,2,0,L|100:0,1,100");
+    std::vector<osu::Vector2> resampled;
+    osu::resample_path(line.points, line.distances, 5, resampled);
+    CHECK(resampled == std::vector<osu::Vector2>{{0, 0}, {25, 0}, {50, 0}, {75, 0}, {100, 0}});
+    osu::resample_path(line.points, line.distances, 1, resampled);
+    CHECK(resampled == std::vector<osu::Vector2>{{0, 0}});
+    osu::resample_path(line.points, line.distances, 0, resampled);
+    CHECK(resampled.empty());
+
+    const auto curve = path_slider("64,320,0,2,0,P|256:40|448:320,1,700");
+    osu::resample_path(curve.points, curve.distances, 200, resampled);
+    REQUIRE(resampled.size() == 200);
+    CHECK(resampled.front() == curve.points.front());
+    CHECK(resampled.back() == curve.points.back());
+    // Chords of a gentle arc are nearly as long as the arc between them
+    const auto spacing = curve.distances.back() / 199;
+    for(std::size_t i = 1; i < resampled.size(); ++i) {
+        CHECK(osu::distance(resampled[i - 1], resampled[i]) == Approx(spacing).epsilon(0.01));
+    }
+}
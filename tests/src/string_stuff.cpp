@@ -88,3 +88,35 @@ TEST_CASE("split string", "[string]")
     REQUIRE(splits[8] == "dog");
     REQUIRE(splits[9] == ",");
 }
+
+TEST_CASE("split fixed tokens", "[string]")
+{
+    osu::Fixed_tokens<4> tokens;
+
+    REQUIRE(tokens.split("256,,192,74363", ','));
+    REQUIRE(tokens.size() == 3);
+    CHECK(tokens[0] == "256");
+    CHECK(tokens[1] == "192");
+    CHECK(tokens[2] == "74363");
+    CHECK_FALSE(tokens.overflowed());
+
+    REQUIRE_FALSE(tokens.split("1,2,3,4,5,6", ','));
+    CHECK(tokens.overflowed());
+    CHECK(tokens.size() == 4);
+    CHECK(tokens[3] == "4");
+
+    const osu::Token_span span = tokens;
+    CHECK(span.size() == 4);
+    CHECK(span[0] == "1");
+}
+
+TEST_CASE("tokenizer", "[string]")
+{
+    auto tokenizer = osu::Tokenizer{"B|380:120||332:96|", '|'};
+
+    CHECK(tokenizer.next() == "B");
+    CHECK(tokenizer.next() == "380:120");
+    CHECK(tokenizer.next() == "332:96");
+    CHECK_FALSE(tokenizer.next());
+    CHECK_FALSE(tokenizer.next());
+}
@@ -1,28 +1,120 @@
+#include <algorithm>
 #include <catch2/catch.hpp>
 #include <osu_reader/beatmap.h>
-#include <timingpoints_helper.h>
+#include <osu_reader/beatmap_parser.h>
+#include <osu_reader/timing_index.h>
 
-TEST_CASE("Timingpoints find_next")
+TEST_CASE("Timing index")
 {
     using namespace std::chrono_literals;
 
-    std::vector<osu::Beatmap::Timingpoint> timingpoints{
-            {10000ms, std::chrono::microseconds{static_cast<int>(333.33f * 1000.f)}, 4, 0, 0, 100, true, true},
-            {12000ms, std::chrono::microseconds{static_cast<int>(200.f * 1000.f)}, 4, 0, 0, 100, false, true},
-            {15000ms, std::chrono::microseconds{static_cast<int>(300.f * 1000.f)}, 4, 0, 0, 100, false, true},
+    // Inherited point at 12000ms doubles slider velocity, the one at 16000ms halves it
+    const std::vector<osu::Beatmap::Timingpoint> timingpoints{
+            {11000ms, 250000us, 4, 1, 0, 100, false, false},
+            {10000ms, 500000us, 4, 1, 0, 100, true, false},
+            {12000ms, 250000us, 4, 2, 1, 80, false, true},
+            {14000ms, 400000us, 3, 1, 0, 100, true, false},
+            {16000ms, 800000us, 4, 3, 0, 50, false, false},
     };
+    const auto index = osu::Timing_index{timingpoints};
+    REQUIRE(index.timings().size() == 2);
+    REQUIRE(index.effects().size() == 5);
+    CHECK(index.effects()[1].time == 11000ms);// Sorted
 
-    REQUIRE(osu::next_timingpoint(timingpoints.cbegin(), timingpoints.cend(), 9000ms)->time == 10000ms);
-    REQUIRE(osu::next_timingpoint(timingpoints.cbegin(), timingpoints.cend(), 10000ms)->time == 10000ms);
-    REQUIRE(osu::next_timingpoint(timingpoints.cbegin(), timingpoints.cend(), 11000ms)->time == 10000ms);
-    REQUIRE(osu::next_timingpoint(timingpoints.cbegin(), timingpoints.cend(), 12000ms)->time == 12000ms);
-
-    auto it = timingpoints.cbegin();
-    REQUIRE(osu::next_timingpoint(it, timingpoints.cend(), 22000ms)->time == 15000ms);
-    it = std::next(it);
-    REQUIRE(osu::next_timingpoint(it, timingpoints.cend(), 22000ms)->time == 15000ms);
-    it = std::next(it);
-    REQUIRE(osu::next_timingpoint(it, timingpoints.cend(), 22000ms)->time == 15000ms);
-    it = std::next(it);
-    REQUIRE(it == timingpoints.cend());
+    const auto before = index.at(0ms);
+    CHECK(before.beat_duration == 500000us);
+    CHECK(before.effective_beat_duration == 500000us);
+    CHECK(before.slider_velocity == 1);
+
+    const auto inherited = index.at(13000ms);
+    CHECK(inherited.beat_duration == 500000us);
+    CHECK(inherited.effective_beat_duration == 250000us);
+    CHECK(inherited.slider_velocity == 2);
+    CHECK(inherited.meter == 4);
+    CHECK(inherited.sample_set == 2);
+    CHECK(inherited.sample_volume == 80);
+    CHECK(inherited.kiai);
+
+    // A new uninherited point resets slider velocity
+    const auto bpm_change = index.at(14000ms);
+    CHECK(bpm_change.beat_duration == 400000us);
+    CHECK(bpm_change.slider_velocity == 1);
+    CHECK(bpm_change.meter == 3);
+    CHECK_FALSE(bpm_change.kiai);
+
+    const auto last = index.at(100000ms);
+    CHECK(last.beat_duration == 400000us);
+    CHECK(last.slider_velocity == 0.5f);
+    CHECK(last.sample_volume == 50);
+
+    const auto empty = osu::Timing_index{}.at(1000ms);
+    CHECK(empty.beat_duration == 0us);
+    CHECK(empty.slider_velocity == 1);
+}
+
+TEST_CASE("Timing index cursor matches searches")
+{
+    using namespace std::chrono_literals;
+
+    std::vector<osu::Beatmap::Timingpoint> timingpoints;
+    for(auto i = 0; i < 1000; ++i) {
+        const auto uninherited = i % 50 == 0;
+        timingpoints.push_back({std::chrono::milliseconds{i * 100 + 1000}, std::chrono::microseconds{uninherited ? 400000 : 400000 + i},
+                                4, i % 3, 0, 100, uninherited, i % 7 == 0});
+    }
+    const auto index = osu::Timing_index{timingpoints};
+    const auto same = [](const osu::Timing_index::State& a, const osu::Timing_index::State& b) {
+        return a.beat_duration == b.beat_duration && a.effective_beat_duration == b.effective_beat_duration &&
+               a.slider_velocity == b.slider_velocity && a.sample_set == b.sample_set && a.kiai == b.kiai;
+    };
+
+    // Sorted, then scattered times
+    auto cursor = index.cursor();
+    for(auto t = 0; t < 110000; t += 37) CHECK(same(cursor.seek(std::chrono::milliseconds{t}), index.at(std::chrono::milliseconds{t})));
+    for(auto t = 0; t < 110000; t += 7919) {
+        const auto scattered = std::chrono::milliseconds{(t * 31) % 110000};
+        CHECK(same(cursor.seek(scattered), index.at(scattered)));
+        // Last point at or before the time, or the first one
+        const auto after = std::find_if(timingpoints.cbegin(), timingpoints.cend(), [scattered](const auto& point) { return point.time > scattered; });
+        const auto active = after == timingpoints.cbegin() ? after : std::prev(after);
+        CHECK(index.at(scattered).effective_beat_duration == active->beat_duration);
+    }
+}
+
+TEST_CASE("Slider durations independent of section and object order")
+{
+    using namespace std::chrono_literals;
+
+    const std::string timing = "[TimingPoints]\n1000,500,4,2,0,60,1,0\n3000,-50,4,2,0,60,0,0\n\n";
+    const std::string difficulty = "[Difficulty]\nSliderMultiplier:1\n\n";
+    // Out of time order, the second slider is in the doubled slider velocity section
+    const std::string hitobjects = "[HitObjects]\n64,64,4000,2,0,L|164:64,1,100\n64,64,2000,2,0,L|164:64,1,100\n0,0,500,2,0,L|50:0,1,50\n\n";
+
+    auto parser = osu::Beatmap_parser{};
+    const auto ordered = parser.from_string("osu file format v14\n\n" + difficulty + timing + hitobjects);
+    const auto reordered = parser.from_string("osu file format v14\n\n" + hitobjects + timing + difficulty);
+    for(const auto& beatmap : {ordered, reordered}) {
+        REQUIRE(beatmap);
+        REQUIRE(beatmap->sliders.size() == 3);
+        CHECK(beatmap->sliders[0].duration == 250ms);
+        CHECK(beatmap->sliders[1].duration == 500ms);
+        CHECK(beatmap->sliders[2].duration == 250ms);// Before the first timing point
+    }
+
+    // So do arena sliders, which are streamed into the arena
+    for(const auto& content : {difficulty + timing + hitobjects, hitobjects + timing + difficulty}) {
+        const auto arena = parser.arena_from_string("osu file format v14\n\n" + content);
+        REQUIRE(arena);
+        REQUIRE(arena->sliders.size() == 3);
+        CHECK(arena->sliders[0].duration == 250ms);
+        CHECK(arena->sliders[1].duration == 500ms);
+        CHECK(arena->sliders[2].duration == 250ms);
+    }
+
+    // Streamed sliders get the same durations
+    std::vector<std::chrono::milliseconds> streamed;
+    parser.stream_string("osu file format v14\n\n" + difficulty + timing + hitobjects, [&](const auto& object) {
+        if constexpr(std::is_same_v<std::decay_t<decltype(object)>, osu::Slider>) streamed.push_back(object.duration);
+    });
+    CHECK(streamed == std::vector<std::chrono::milliseconds>{250ms, 500ms, 250ms});
 }